@@ -0,0 +1,319 @@
+// File:  alertManager.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Persistent alert state machine with hysteresis, re-notification, escalation
+//        and coalescing of notifications into a single digest.
+
+// Local headers
+#include "alertManager.h"
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+AlertManager::AlertManager(const std::string& stateFileName, UString::OStream& log) : stateFileName(stateFileName), log(log)
+{
+	ReadState();
+}
+
+void AlertManager::EvaluateBelow(const AlertType& type, const double& value, const double& threshold, const double& hysteresis, const std::string& detail, const TimePoint& now)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	const AlertState& state(alerts[static_cast<size_t>(type)]);
+	if (!state.active && value < threshold)
+		SetActive(type, true, detail, now);
+	else if (state.active && value >= threshold + hysteresis)
+		SetActive(type, false, detail, now);
+	else
+		alerts[static_cast<size_t>(type)].detail = detail;
+}
+
+void AlertManager::EvaluateCondition(const AlertType& type, const bool& active, const std::string& detail, const TimePoint& now)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (alerts[static_cast<size_t>(type)].active != active)
+		SetActive(type, active, detail, now);
+	else
+		alerts[static_cast<size_t>(type)].detail = detail;
+}
+
+void AlertManager::RaiseEvent(const AlertType& type, const std::string& detail, const TimePoint& now)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	AlertState& state(alerts[static_cast<size_t>(type)]);
+	state.active = false;
+	state.activatedSinceNotify = true;
+	state.clearedSinceNotify = false;
+	state.since = now;
+	if (state.detail.empty())
+		state.detail = detail;
+	else
+		state.detail += "\n" + detail;// Several events between notifications (cleared by MarkSent)
+
+	log << "Alert '" << GetName(type) << "' raised" << std::endl;
+	WriteState();
+}
+
+void AlertManager::SetActive(const AlertType& type, const bool& active, const std::string& detail, const TimePoint& now)
+{
+	AlertState& state(alerts[static_cast<size_t>(type)]);
+	state.active = active;
+	state.since = now;
+	state.detail = detail;
+	if (active)
+		state.activatedSinceNotify = true;
+	else
+		state.clearedSinceNotify = true;
+
+	log << "Alert '" << GetName(type) << "' " << (active ? "raised" : "cleared") << std::endl;
+	WriteState();
+}
+
+AlertManager::Digest AlertManager::BuildDigest(const AlertConfig& config, const std::string& debugText, const TimePoint& now) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto renotifyPeriod(std::chrono::hours(config.renotifyPeriod));
+
+	Digest digest;
+	std::ostringstream body;
+	bool escalated(false);
+	unsigned int activeCount(0);
+	unsigned int eventCount(0);
+	for (size_t i = 0; i < alerts.size(); ++i)
+	{
+		const AlertState& state(alerts[i]);
+		const AlertType type(static_cast<AlertType>(i));
+		const bool stateChanged(state.activatedSinceNotify || state.clearedSinceNotify);
+		const bool reminderDue(state.active && now - state.lastNotified >= renotifyPeriod);
+		if (!stateChanged && !reminderDue)
+			continue;
+
+		digest.included.push_back(type);
+		if (IsEvent(type))
+		{
+			++eventCount;
+			body << "DETECTED:  " << GetTitle(type) << "\n" << state.detail << "\n\n";
+		}
+		else if (state.active)
+		{
+			++activeCount;
+			if (state.notifyCount >= config.escalateAfter)
+				escalated = true;
+			body << (state.activatedSinceNotify ? "NEW" : "STILL ACTIVE") << ":  " << GetTitle(type) << "\n" << state.detail << "\n\n";
+		}
+		else if (state.activatedSinceNotify)// Raised and cleared again between notifications
+			body << "OCCURRED AND RESOLVED:  " << GetTitle(type) << "\n" << state.detail << "\n\n";
+		else
+			body << "RESOLVED:  " << GetTitle(type) << "\n" << state.detail << "\n\n";
+	}
+
+	if (!debugText.empty() && (!digest.included.empty() || now - lastDebugSent >= renotifyPeriod))
+	{
+		digest.includesDebug = true;
+		body << "Debug information:\n" << debugText << "\n";
+	}
+
+	if (digest.included.size() == 1 && activeCount + eventCount == 1)
+		digest.subject = GetTitle(digest.included.front());
+	else if (eventCount > 0)
+		digest.subject = "Oil Level Checker:  " + std::to_string(activeCount + eventCount) + " Alerts";
+	else if (activeCount > 0)
+		digest.subject = "Oil Level Checker:  " + std::to_string(activeCount) + " Active Alerts";
+	else if (!digest.included.empty())
+		digest.subject = "Oil Level Checker:  Alert Resolved";
+	else
+		digest.subject = "Oil Level Checker Debug Message";
+
+	if (escalated)
+		digest.subject = "URGENT:  " + digest.subject;
+
+	digest.body = body.str();
+	return digest;
+}
+
+void AlertManager::MarkSent(const Digest& digest, const TimePoint& now)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (const auto& type : digest.included)
+	{
+		AlertState& state(alerts[static_cast<size_t>(type)]);
+		state.activatedSinceNotify = false;
+		state.clearedSinceNotify = false;
+		state.lastNotified = now;
+		if (IsEvent(type))
+			state.detail.clear();
+		if (state.active)
+			++state.notifyCount;
+		else
+			state.notifyCount = 0;
+	}
+
+	if (digest.includesDebug)
+		lastDebugSent = now;
+
+	WriteState();
+}
+
+bool AlertManager::IsEvent(const AlertType& type)
+{
+	return type == AlertType::AbnormalDrop || type == AlertType::Refill;
+}
+
+std::string AlertManager::GetName(const AlertType& type)
+{
+	switch (type)
+	{
+	case AlertType::LowLevel:
+		return "LOW_LEVEL";
+
+	case AlertType::DaysToEmpty:
+		return "DAYS_TO_EMPTY";
+
+	case AlertType::AbnormalDrop:
+		return "ABNORMAL_DROP";
+
+	case AlertType::Refill:
+		return "REFILL";
+
+	case AlertType::SensorFault:
+		return "SENSOR_FAULT";
+
+	default:
+		break;
+	}
+
+	return "UNKNOWN";
+}
+
+std::string AlertManager::GetTitle(const AlertType& type)
+{
+	switch (type)
+	{
+	case AlertType::LowLevel:
+		return "Low Oil Level Detected";
+
+	case AlertType::DaysToEmpty:
+		return "Oil Tank Projected to Run Out Soon";
+
+	case AlertType::AbnormalDrop:
+		return "Unexpected Loss of Oil Detected";
+
+	case AlertType::Refill:
+		return "Oil Tank Refill Detected";
+
+	case AlertType::SensorFault:
+		return "Oil Level Sensor May Be Faulty";
+
+	default:
+		break;
+	}
+
+	return "Unknown Alert";
+}
+
+// One line per alert:  <name> <active> <activated> <cleared> <since> <last notified> <count> <detail>
+// Times are seconds since the epoch.  The detail is the rest of the line, with backslashes,
+// newlines and carriage returns escaped; files written without it read as an empty detail.
+void AlertManager::ReadState()
+{
+	std::ifstream file(stateFileName);
+	if (!file.is_open())
+		return;// No alerts have ever been raised
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream ss(line);
+		std::string name;
+		AlertState state;
+		long long since, lastNotified;
+		if ((ss >> name >> state.active >> state.activatedSinceNotify >> state.clearedSinceNotify >> since >> lastNotified >> state.notifyCount).fail())
+		{
+			log << "Warning:  Ignoring malformed line in '" << stateFileName << "'" << std::endl;
+			continue;
+		}
+
+		std::string detail;
+		if (ss.get() == ' ' && std::getline(ss, detail))
+			state.detail = UnescapeDetail(detail);
+
+		state.since = TimePoint(std::chrono::seconds(since));
+		state.lastNotified = TimePoint(std::chrono::seconds(lastNotified));
+		for (size_t i = 0; i < alerts.size(); ++i)
+		{
+			if (GetName(static_cast<AlertType>(i)) == name)
+				alerts[i] = state;
+		}
+	}
+}
+
+void AlertManager::WriteState() const
+{
+	const std::string tempFileName(stateFileName + ".tmp");
+	{
+		std::ofstream file(tempFileName);
+		if (!file.is_open())
+		{
+			log << "Failed to open '" << tempFileName << "' for output" << std::endl;
+			return;
+		}
+
+		for (size_t i = 0; i < alerts.size(); ++i)
+		{
+			const AlertState& state(alerts[i]);
+			file << GetName(static_cast<AlertType>(i)) << ' ' << state.active << ' ' << state.activatedSinceNotify << ' ' << state.clearedSinceNotify << ' '
+				<< std::chrono::duration_cast<std::chrono::seconds>(state.since.time_since_epoch()).count() << ' '
+				<< std::chrono::duration_cast<std::chrono::seconds>(state.lastNotified.time_since_epoch()).count() << ' '
+				<< state.notifyCount << ' ' << EscapeDetail(state.detail) << '\n';
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempFileName, stateFileName, ec);
+	if (ec)
+		log << "Failed to update '" << stateFileName << "':  " << ec.message() << std::endl;
+}
+
+std::string AlertManager::EscapeDetail(const std::string& detail)
+{
+	std::string escaped;
+	escaped.reserve(detail.size());
+	for (const auto& c : detail)
+	{
+		if (c == '\\')
+			escaped.append("\\\\");
+		else if (c == '\n')
+			escaped.append("\\n");
+		else if (c == '\r')
+			escaped.append("\\r");
+		else
+			escaped.push_back(c);
+	}
+
+	return escaped;
+}
+
+std::string AlertManager::UnescapeDetail(const std::string& escaped)
+{
+	std::string detail;
+	detail.reserve(escaped.size());
+	for (size_t i = 0; i < escaped.size(); ++i)
+	{
+		if (escaped[i] != '\\' || i + 1 == escaped.size())
+		{
+			detail.push_back(escaped[i]);
+			continue;
+		}
+
+		const char c(escaped[++i]);
+		if (c == 'n')
+			detail.push_back('\n');
+		else if (c == 'r')
+			detail.push_back('\r');
+		else
+			detail.push_back(c);
+	}
+
+	return detail;
+}
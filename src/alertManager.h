@@ -0,0 +1,98 @@
+// File:  alertManager.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Persistent alert state machine with hysteresis, re-notification, escalation
+//        and coalescing of notifications into a single digest.
+
+#ifndef ALERT_MANAGER_H_
+#define ALERT_MANAGER_H_
+
+// Local headers
+#include "oilCheckerConfig.h"
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class AlertManager
+{
+public:
+	AlertManager(const std::string& stateFileName, UString::OStream& log);
+
+	enum class AlertType
+	{
+		LowLevel,
+		DaysToEmpty,
+		AbnormalDrop,
+		Refill,
+		SensorFault,
+
+		Count
+	};
+
+	typedef std::chrono::system_clock::time_point TimePoint;
+
+	// Becomes active when value < threshold; clears only once value >= threshold + hysteresis
+	void EvaluateBelow(const AlertType& type, const double& value, const double& threshold, const double& hysteresis, const std::string& detail, const TimePoint& now);
+
+	// For conditions whose hysteresis is handled by the caller
+	void EvaluateCondition(const AlertType& type, const bool& active, const std::string& detail, const TimePoint& now);
+
+	// For one-off events (e.g. a refill), which are reported once and never remain active
+	void RaiseEvent(const AlertType& type, const std::string& detail, const TimePoint& now);
+
+	struct Digest
+	{
+		std::string subject;
+		std::string body;
+		std::vector<AlertType> included;
+		bool includesDebug = false;
+
+		bool IsEmpty() const { return included.empty() && !includesDebug; }
+	};
+
+	// Collects every unreported state change plus any reminders that are due.  Debug text is
+	// attached to any digest, and sent on its own no more often than the re-notify period.
+	Digest BuildDigest(const AlertConfig& config, const std::string& debugText, const TimePoint& now) const;
+
+	// Call only after the digest was delivered; undelivered changes are reported again next time
+	void MarkSent(const Digest& digest, const TimePoint& now);
+
+private:
+	const std::string stateFileName;
+	UString::OStream& log;
+
+	struct AlertState
+	{
+		bool active = false;
+		bool activatedSinceNotify = false;
+		bool clearedSinceNotify = false;
+		TimePoint since;
+		TimePoint lastNotified;
+		unsigned int notifyCount = 0;
+		std::string detail;
+	};
+
+	mutable std::mutex mutex;
+	std::array<AlertState, static_cast<size_t>(AlertType::Count)> alerts;
+	TimePoint lastDebugSent;
+
+	void SetActive(const AlertType& type, const bool& active, const std::string& detail, const TimePoint& now);
+
+	static bool IsEvent(const AlertType& type);
+	static std::string GetName(const AlertType& type);
+	static std::string GetTitle(const AlertType& type);
+
+	void ReadState();
+	void WriteState() const;
+
+	// Details may span several lines, but each alert's state must stay on one line of the file
+	static std::string EscapeDetail(const std::string& detail);
+	static std::string UnescapeDetail(const std::string& escaped);
+};
+
+#endif// ALERT_MANAGER_H_
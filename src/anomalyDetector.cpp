@@ -0,0 +1,117 @@
+// File:  anomalyDetector.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Streaming detection of abnormal consumption, refills and sensor faults.
+
+// Local headers
+#include "anomalyDetector.h"
+
+// Standard C++ headers
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+
+const double AnomalyDetector::rateSmoothing(0.05);
+const double AnomalyDetector::rejectionSmoothing(0.2);
+const unsigned int AnomalyDetector::minRateSamples(12);
+
+AnomalyDetector::VolumeResult AnomalyDetector::AddVolume(const AnomalyConfig& config, const TimePoint& t, const double& volume, const double& expectedRate)
+{
+	VolumeResult result;
+	if (!haveVolume)
+	{
+		haveVolume = true;
+		lastVolumeTime = t;
+		lastVolume = volume;
+		ResetExcess();
+		return result;
+	}
+
+	const double days(DaysBetween(lastVolumeTime, t));
+	const double used(lastVolume - volume);
+	lastVolumeTime = t;
+	lastVolume = volume;
+
+	if (-used > config.refillVolume)
+	{
+		result.refill = true;
+		result.volumeChange = -used;
+		ResetExcess();
+		return result;
+	}
+
+	if (days <= 0.0)
+		return result;
+
+	const bool useLearnedRate(std::isnan(expectedRate));
+	if (useLearnedRate && rateSamples < minRateSamples)
+	{
+		// Not enough history to know what normal consumption looks like
+		learnedRate += (rateSamples == 0 ? 1.0 : rateSmoothing) * (std::max(0.0, used / days) - learnedRate);
+		++rateSamples;
+		return result;
+	}
+
+	const double rate(useLearnedRate ? learnedRate : std::max(0.0, expectedRate));
+	if (excessSum == 0.0)
+		excessStart = t - std::chrono::duration_cast<TimePoint::duration>(std::chrono::duration<double, std::ratio<86400>>(days));
+	excessSum = std::max(0.0, excessSum + used - (rate + config.dropAllowance) * days);
+
+	if (excessSum > config.dropThreshold)
+	{
+		result.abnormalDrop = true;
+		result.volumeChange = excessSum;
+		result.days = DaysBetween(excessStart, t);
+		ResetExcess();
+	}
+	else if (excessSum == 0.0)
+	{
+		// Only learn from intervals that look normal, so a leak doesn't become the new baseline
+		learnedRate += rateSmoothing * (std::max(0.0, used / days) - learnedRate);
+		++rateSamples;
+	}
+
+	return result;
+}
+
+bool AnomalyDetector::AddSensorQuality(const AnomalyConfig& config, const SensorQuality& quality, std::string& detail)
+{
+	if (quality.attempts > 0)
+	{
+		const double rejected(static_cast<double>(quality.attempts - quality.accepted) / quality.attempts);
+		rejectionRate += (haveRejectionRate ? rejectionSmoothing : 1.0) * (rejected - rejectionRate);
+		haveRejectionRate = true;
+	}
+
+	// Real echoes always jitter by a few microseconds, so identical pings suggest a stuck reading
+	if (quality.accepted > 1 && quality.stdDev == 0.0)
+		++zeroVarianceCount;
+	else
+		zeroVarianceCount = 0;
+
+	const bool stuck(config.stuckSampleCount > 0 && zeroVarianceCount >= config.stuckSampleCount);
+	if (stuck || rejectionRate > config.maxRejectionRate)
+		sensorFault = true;
+	else if (zeroVarianceCount == 0 && rejectionRate < 0.5 * config.maxRejectionRate)
+		sensorFault = false;
+
+	std::ostringstream ss;
+	ss.precision(0);
+	ss << std::fixed;
+	if (stuck)
+		ss << "The last " << zeroVarianceCount << " measurements each returned identical pings, which suggests the distance sensor is stuck.  ";
+	ss << "On average " << rejectionRate * 100.0 << "% of pings are being rejected as out of range (alert threshold is " << config.maxRejectionRate * 100.0 << "%).";
+	detail = ss.str();
+
+	return sensorFault;
+}
+
+void AnomalyDetector::ResetExcess()
+{
+	excessSum = 0.0;
+}
+
+double AnomalyDetector::DaysBetween(const TimePoint& a, const TimePoint& b)
+{
+	return std::chrono::duration<double, std::ratio<86400>>(b - a).count();
+}
@@ -0,0 +1,71 @@
+// File:  anomalyDetector.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Streaming detection of abnormal consumption, refills and sensor faults.
+
+#ifndef ANOMALY_DETECTOR_H_
+#define ANOMALY_DETECTOR_H_
+
+// Local headers
+#include "oilCheckerConfig.h"
+
+// Standard C++ headers
+#include <chrono>
+#include <string>
+
+// Runs a one-sided CUSUM on oil used in excess of the expected consumption rate, so a sudden
+// loss (theft) trips on a single sample while a slow leak accumulates until it crosses the
+// threshold.  Normal measurement noise decays the sum back to zero.  Every sample costs a
+// constant amount of work and no history is kept.
+class AnomalyDetector
+{
+public:
+	typedef std::chrono::system_clock::time_point TimePoint;
+
+	struct VolumeResult
+	{
+		bool refill = false;
+		bool abnormalDrop = false;
+		double volumeChange = 0.0;// [gal] added by the refill, or lost in excess of normal use
+		double days = 0.0;// Period over which the excess loss accumulated
+	};
+
+	// expectedRate [gal/day] may be NaN, in which case a smoothed rate learned from the samples is used
+	VolumeResult AddVolume(const AnomalyConfig& config, const TimePoint& t, const double& volume, const double& expectedRate);
+
+	struct SensorQuality
+	{
+		unsigned int attempts;
+		unsigned int accepted;
+		double stdDev;// Across accepted pings (units don't matter; only zero is significant)
+	};
+
+	// Returns true while the sensor appears faulty; the reason is written to detail
+	bool AddSensorQuality(const AnomalyConfig& config, const SensorQuality& quality, std::string& detail);
+
+private:
+	static const double rateSmoothing;
+	static const double rejectionSmoothing;
+	static const unsigned int minRateSamples;
+
+	bool haveVolume = false;
+	TimePoint lastVolumeTime;
+	double lastVolume;
+
+	double learnedRate = 0.0;// [gal/day]
+	unsigned int rateSamples = 0;
+
+	double excessSum = 0.0;// [gal]
+	TimePoint excessStart;
+
+	bool haveRejectionRate = false;
+	double rejectionRate = 0.0;
+	unsigned int zeroVarianceCount = 0;
+	bool sensorFault = false;
+
+	void ResetExcess();
+
+	static double DaysBetween(const TimePoint& a, const TimePoint& b);
+};
+
+#endif// ANOMALY_DETECTOR_H_
@@ -0,0 +1,359 @@
+// File:  archiveCatalog.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Persistent index of rotated log archives for direct time-range lookups.
+
+// Local headers
+#include "archiveCatalog.h"
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <mutex>
+
+const unsigned int ArchiveCatalog::rowsPerBlock(256);
+
+ArchiveCatalog::ArchiveCatalog(const std::string& catalogFileName, const TimeParser& parseTime, UString::OStream& log)
+	: catalogFileName(catalogFileName), parseTime(parseTime), log(log)
+{
+	ReadCatalog();
+}
+
+bool ArchiveCatalog::AddArchive(const Series& series, const std::string& fileName)
+{
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		const auto& list(archives[static_cast<size_t>(series)]);
+		if (std::any_of(list.begin(), list.end(), [&fileName](const Archive& a) { return a.fileName == fileName; }))
+			return true;
+	}
+
+	// Scan without holding the lock so queries aren't held up
+	Archive archive;
+	if (!IndexArchive(fileName, archive))
+		return false;
+
+	std::unique_lock<std::shared_mutex> lock(mutex);
+	auto& list(archives[static_cast<size_t>(series)]);
+
+	// Another thread may have cataloged the same file while we were scanning
+	if (std::any_of(list.begin(), list.end(), [&fileName](const Archive& a) { return a.fileName == fileName; }))
+		return true;
+
+	list.insert(std::upper_bound(list.begin(), list.end(), archive, [](const Archive& a, const Archive& b)
+	{
+		return a.firstTime < b.firstTime;
+	}), archive);
+	WriteCatalog();
+
+	log << "Cataloged '" << fileName << "' (" << archive.rowCount << " rows" << (archive.sorted ? "" : ", not in time order") << ")" << std::endl;
+	return true;
+}
+
+void ArchiveCatalog::Reconcile(const Series& series, const std::vector<std::string>& archiveFileNames)
+{
+	{
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		auto& list(archives[static_cast<size_t>(series)]);
+		const auto removed(std::remove_if(list.begin(), list.end(), [&archiveFileNames](const Archive& a)
+		{
+			return std::find(archiveFileNames.begin(), archiveFileNames.end(), a.fileName) == archiveFileNames.end();
+		}));
+
+		if (removed != list.end())
+		{
+			list.erase(removed, list.end());
+			WriteCatalog();
+		}
+	}
+
+	for (const auto& fileName : archiveFileNames)
+		AddArchive(series, fileName);
+}
+
+bool ArchiveCatalog::IndexArchive(const std::string& fileName, Archive& archive) const
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file.is_open())
+	{
+		log << "Warning:  Failed to open '" << fileName << "' for cataloging" << std::endl;
+		return false;
+	}
+
+	archive.fileName = fileName;
+	archive.rowCount = 0;
+	archive.sorted = true;
+
+	std::string line;
+	std::getline(file, line);// Discard header row
+	std::int64_t offset(file.tellg());
+	Row row;
+	EpochSeconds previousTime(0);
+	while (std::getline(file, line))
+	{
+		if (ParseRow(line, row))
+		{
+			if (archive.rowCount % rowsPerBlock == 0)
+				archive.blocks.push_back(Block{row.t, offset});
+			if (archive.rowCount == 0)
+			{
+				archive.firstTime = row.t;
+				archive.lastTime = row.t;
+			}
+			else if (row.t < previousTime)
+				archive.sorted = false;
+
+			archive.firstTime = std::min(archive.firstTime, row.t);
+			archive.lastTime = std::max(archive.lastTime, row.t);
+			previousTime = row.t;
+			++archive.rowCount;
+		}
+
+		offset = file.tellg();
+	}
+
+	if (archive.rowCount == 0)
+	{
+		log << "Warning:  '" << fileName << "' contains no data; not cataloged" << std::endl;
+		return false;
+	}
+
+	// Block start times can't be searched if the rows aren't in order
+	if (!archive.sorted)
+		archive.blocks.resize(1);
+
+	return true;
+}
+
+bool ArchiveCatalog::ParseRow(const std::string& line, Row& row) const
+{
+	std::istringstream ss(line);
+	std::string token;
+	if (!std::getline(ss, token, ',') || !parseTime(token, row.t))
+		return false;
+
+	row.values.clear();
+	while (std::getline(ss, token, ','))
+	{
+		std::istringstream valueSS(token);
+		double value;
+		if ((valueSS >> value).fail())
+			return false;
+		row.values.push_back(value);
+	}
+
+	return true;
+}
+
+bool ArchiveCatalog::Query(const Series& series, const EpochSeconds& from, const EpochSeconds& to, std::vector<Row>& rows) const
+{
+	struct Source
+	{
+		bool sorted;
+		std::ifstream file;
+	};
+
+	// Open the files under the lock, so an archive that is replaced or removed meanwhile is still
+	// readable, but read them after releasing it so rotation and compaction aren't held up
+	std::vector<Source> sources;
+	bool ok(true);
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		for (const auto& archive : archives[static_cast<size_t>(series)])
+		{
+			if (archive.lastTime < from || archive.firstTime > to)
+				continue;
+
+			std::ifstream file(archive.fileName, std::ios::binary);
+			if (!file.is_open())
+			{
+				log << "Warning:  Cataloged archive '" << archive.fileName << "' could not be opened" << std::endl;
+				ok = false;
+				continue;
+			}
+
+			// Start in the last block that begins at or before the requested time
+			auto block(std::upper_bound(archive.blocks.begin(), archive.blocks.end(), from, [](const EpochSeconds& t, const Block& b)
+			{
+				return t < b.firstTime;
+			}));
+			if (block != archive.blocks.begin())
+				--block;
+			file.seekg(block->offset);
+
+			sources.push_back(Source{archive.sorted, std::move(file)});
+		}
+	}
+
+	for (auto& source : sources)
+	{
+		const std::size_t firstRow(rows.size());
+		std::string line;
+		Row row;
+		while (std::getline(source.file, line))
+		{
+			if (!ParseRow(line, row))
+				continue;
+			if (row.t > to && source.sorted)
+				break;
+			if (row.t >= from && row.t <= to)
+				rows.push_back(row);
+		}
+
+		if (!source.sorted)
+		{
+			std::stable_sort(rows.begin() + firstRow, rows.end(), [](const Row& a, const Row& b)
+			{
+				return a.t < b.t;
+			});
+		}
+	}
+
+	return ok;
+}
+
+std::vector<ArchiveCatalog::Summary> ArchiveCatalog::List(const Series& series) const
+{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	std::vector<Summary> summaries;
+	for (const auto& archive : archives[static_cast<size_t>(series)])
+		summaries.push_back(Summary{archive.fileName, archive.firstTime, archive.lastTime});
+	return summaries;
+}
+
+bool ArchiveCatalog::ReplaceArchive(const Series& series, const std::string& oldFileName, const std::string& newFileName)
+{
+	Archive archive;
+	if (!IndexArchive(newFileName, archive))
+		return false;
+
+	std::unique_lock<std::shared_mutex> lock(mutex);
+	auto& list(archives[static_cast<size_t>(series)]);
+	list.erase(std::remove_if(list.begin(), list.end(), [&oldFileName, &newFileName](const Archive& a)
+	{
+		return a.fileName == oldFileName || a.fileName == newFileName;
+	}), list.end());
+	list.insert(std::upper_bound(list.begin(), list.end(), archive, [](const Archive& a, const Archive& b)
+	{
+		return a.firstTime < b.firstTime;
+	}), archive);
+	WriteCatalog();
+
+	log << "Cataloged '" << newFileName << "' (" << archive.rowCount << " rows) in place of '" << oldFileName << "'" << std::endl;
+	return true;
+}
+
+void ArchiveCatalog::RemoveArchive(const Series& series, const std::string& fileName)
+{
+	std::unique_lock<std::shared_mutex> lock(mutex);
+	auto& list(archives[static_cast<size_t>(series)]);
+	const auto removed(std::remove_if(list.begin(), list.end(), [&fileName](const Archive& a) { return a.fileName == fileName; }));
+	if (removed == list.end())
+		return;
+
+	list.erase(removed, list.end());
+	WriteCatalog();
+}
+
+std::string ArchiveCatalog::GetName(const Series& series)
+{
+	switch (series)
+	{
+	case Series::Oil:
+		return "OIL";
+
+	case Series::Temperature:
+		return "TEMPERATURE";
+
+	default:
+		break;
+	}
+
+	return "UNKNOWN";
+}
+
+// One line per archive:  <series> <first t> <last t> <rows> <sorted> <block count> [<block t> <offset>]... <file name>
+// Times are seconds since the epoch and sorted is 0 or 1; the file name is last so it may contain spaces.
+void ArchiveCatalog::ReadCatalog()
+{
+	std::ifstream file(catalogFileName);
+	if (!file.is_open())
+		return;// Nothing has been rotated yet
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream ss(line);
+		std::string name;
+		Archive archive;
+		std::size_t blockCount;
+		bool ok(!(ss >> name >> archive.firstTime >> archive.lastTime >> archive.rowCount >> archive.sorted >> blockCount).fail());
+		for (std::size_t i = 0; ok && i < blockCount; ++i)
+		{
+			Block block;
+			ok = !(ss >> block.firstTime >> block.offset).fail();
+			archive.blocks.push_back(block);
+		}
+
+		if (ok)
+		{
+			ss >> std::ws;
+			ok = static_cast<bool>(std::getline(ss, archive.fileName)) && !archive.blocks.empty();
+		}
+
+		size_t i;
+		for (i = 0; i < archives.size(); ++i)
+		{
+			if (GetName(static_cast<Series>(i)) == name)
+				break;
+		}
+
+		if (!ok || i == archives.size())
+		{
+			log << "Warning:  Ignoring malformed line in '" << catalogFileName << "'" << std::endl;
+			continue;
+		}
+
+		archives[i].push_back(archive);
+	}
+
+	for (auto& list : archives)
+	{
+		std::sort(list.begin(), list.end(), [](const Archive& a, const Archive& b)
+		{
+			return a.firstTime < b.firstTime;
+		});
+	}
+}
+
+void ArchiveCatalog::WriteCatalog() const
+{
+	const std::string tempFileName(catalogFileName + ".tmp");
+	{
+		std::ofstream file(tempFileName);
+		if (!file.is_open())
+		{
+			log << "Failed to open '" << tempFileName << "' for output" << std::endl;
+			return;
+		}
+
+		for (size_t i = 0; i < archives.size(); ++i)
+		{
+			for (const auto& archive : archives[i])
+			{
+				file << GetName(static_cast<Series>(i)) << ' ' << archive.firstTime << ' ' << archive.lastTime << ' '
+					<< archive.rowCount << ' ' << archive.sorted << ' ' << archive.blocks.size();
+				for (const auto& block : archive.blocks)
+					file << ' ' << block.firstTime << ' ' << block.offset;
+				file << ' ' << archive.fileName << '\n';
+			}
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempFileName, catalogFileName, ec);
+	if (ec)
+		log << "Failed to update '" << catalogFileName << "':  " << ec.message() << std::endl;
+}
@@ -0,0 +1,106 @@
+// File:  archiveCatalog.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Persistent index of rotated log archives for direct time-range lookups.
+
+#ifndef ARCHIVE_CATALOG_H_
+#define ARCHIVE_CATALOG_H_
+
+// Local headers
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <array>
+#include <functional>
+#include <shared_mutex>
+#include <cstdint>
+
+// Each archive is scanned once (when it is rotated) to record its time range, row count and the
+// byte offset of every block of rows.  A query then opens only the archives whose range overlaps
+// the request and seeks straight to the block containing the start time.  Legacy archives with
+// local time stamps can step back an hour when daylight saving time ends; these are flagged as
+// unsorted and always read from the start.
+class ArchiveCatalog
+{
+public:
+	typedef std::int64_t EpochSeconds;// UTC
+	typedef std::function<bool(const std::string& token, EpochSeconds& t)> TimeParser;
+
+	enum class Series
+	{
+		Oil,
+		Temperature,
+
+		Count
+	};
+
+	ArchiveCatalog(const std::string& catalogFileName, const TimeParser& parseTime, UString::OStream& log);
+
+	// Indexes the archive (a CSV log with a header row); already-cataloged files are skipped
+	bool AddArchive(const Series& series, const std::string& fileName);
+
+	// Catalogs any archives that are missing (e.g. rotated by an older version) and forgets deleted ones
+	void Reconcile(const Series& series, const std::vector<std::string>& archiveFileNames);
+
+	struct Row
+	{
+		EpochSeconds t;
+		std::vector<double> values;
+	};
+
+	// Appends rows with from <= t <= to, in time order
+	bool Query(const Series& series, const EpochSeconds& from, const EpochSeconds& to, std::vector<Row>& rows) const;
+
+	struct Summary
+	{
+		std::string fileName;
+		EpochSeconds firstTime;
+		EpochSeconds lastTime;
+	};
+
+	// Cataloged archives, oldest first
+	std::vector<Summary> List(const Series& series) const;
+
+	// Swaps in a new archive covering the same data (e.g. downsampled); queries see either the
+	// old archive or the new one, never both.  The caller is responsible for deleting the old file.
+	bool ReplaceArchive(const Series& series, const std::string& oldFileName, const std::string& newFileName);
+	void RemoveArchive(const Series& series, const std::string& fileName);
+
+private:
+	static const unsigned int rowsPerBlock;
+
+	const std::string catalogFileName;
+	const TimeParser parseTime;
+	UString::OStream& log;
+
+	struct Block
+	{
+		EpochSeconds firstTime;
+		std::int64_t offset;// [bytes] from the start of the file
+	};
+
+	struct Archive
+	{
+		std::string fileName;
+		EpochSeconds firstTime;
+		EpochSeconds lastTime;
+		std::uint64_t rowCount;
+		bool sorted;// Otherwise there is a single block and queries read the whole archive
+		std::vector<Block> blocks;
+	};
+
+	mutable std::shared_mutex mutex;
+	std::array<std::vector<Archive>, static_cast<size_t>(Series::Count)> archives;// Sorted by first time
+
+	bool IndexArchive(const std::string& fileName, Archive& archive) const;
+	bool ParseRow(const std::string& line, Row& row) const;
+
+	static std::string GetName(const Series& series);
+
+	void ReadCatalog();
+	void WriteCatalog() const;
+};
+
+#endif// ARCHIVE_CATALOG_H_
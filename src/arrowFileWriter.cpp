@@ -0,0 +1,418 @@
+// File:  arrowFileWriter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Streaming writer for Arrow IPC (Feather V2) files of time series data.
+
+// Local headers
+#include "arrowFileWriter.h"
+
+// Standard C++ headers
+#include <memory>
+#include <cstring>
+#include <algorithm>
+
+// Layout follows the Arrow columnar format specification (Schema.fbs, Message.fbs and File.fbs,
+// metadata version V5).  All values are written in host byte order, which must be little endian.
+
+namespace
+{
+
+void Align(std::string& buffer, const std::size_t& alignment)
+{
+	buffer.resize((buffer.size() + alignment - 1) / alignment * alignment, '\0');
+}
+
+template<typename T>
+void Put(std::string& buffer, const T& value)
+{
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void Patch(std::string& buffer, const std::size_t& position, const T& value)
+{
+	std::memcpy(&buffer[position], &value, sizeof(T));
+}
+
+// Minimal flatbuffer serializer.  Objects are written front to back with each parent ahead of
+// its children, so every offset points forward as the format requires.
+class FlatNode
+{
+public:
+	virtual ~FlatNode() = default;
+
+	// Returns the position of the object within the buffer
+	virtual uint32_t Serialize(std::string& buffer) const = 0;
+};
+
+class FlatTable : public FlatNode
+{
+public:
+	template<typename T>
+	FlatTable& AddScalar(const uint16_t& slot, const T& value)
+	{
+		Field field;
+		field.slot = slot;
+		field.alignment = sizeof(T);
+		Put(field.bytes, value);
+		fields.push_back(std::move(field));
+		return *this;
+	}
+
+	FlatTable& AddChild(const uint16_t& slot, std::unique_ptr<FlatNode> child)
+	{
+		Field field;
+		field.slot = slot;
+		field.alignment = sizeof(uint32_t);
+		field.bytes.assign(sizeof(uint32_t), '\0');
+		field.child = std::move(child);
+		fields.push_back(std::move(field));
+		return *this;
+	}
+
+	uint32_t Serialize(std::string& buffer) const override
+	{
+		uint16_t slotCount(0);
+		for (const auto& field : fields)
+			slotCount = std::max(slotCount, static_cast<uint16_t>(field.slot + 1));
+
+		Align(buffer, sizeof(uint16_t));
+		const std::size_t vtablePosition(buffer.size());
+		buffer.resize(buffer.size() + 2 * sizeof(uint16_t) + slotCount * sizeof(uint16_t), '\0');
+		Patch(buffer, vtablePosition, static_cast<uint16_t>(buffer.size() - vtablePosition));
+
+		Align(buffer, sizeof(int64_t));
+		const std::size_t tablePosition(buffer.size());
+		Put(buffer, static_cast<int32_t>(tablePosition - vtablePosition));
+
+		std::vector<std::size_t> fieldPositions;
+		for (const auto& field : fields)
+		{
+			Align(buffer, field.alignment);
+			fieldPositions.push_back(buffer.size());
+			Patch(buffer, vtablePosition + (2 + field.slot) * sizeof(uint16_t), static_cast<uint16_t>(buffer.size() - tablePosition));
+			buffer.append(field.bytes);
+		}
+
+		Patch(buffer, vtablePosition + sizeof(uint16_t), static_cast<uint16_t>(buffer.size() - tablePosition));
+
+		for (std::size_t i = 0; i < fields.size(); ++i)
+		{
+			if (fields[i].child)
+			{
+				const uint32_t childPosition(fields[i].child->Serialize(buffer));
+				Patch(buffer, fieldPositions[i], static_cast<uint32_t>(childPosition - fieldPositions[i]));
+			}
+		}
+
+		return static_cast<uint32_t>(tablePosition);
+	}
+
+private:
+	struct Field
+	{
+		uint16_t slot;
+		std::size_t alignment;
+		std::string bytes;
+		std::unique_ptr<FlatNode> child;
+	};
+
+	std::vector<Field> fields;
+};
+
+class FlatVector : public FlatNode
+{
+public:
+	FlatVector& Add(std::unique_ptr<FlatNode> element)
+	{
+		elements.push_back(std::move(element));
+		return *this;
+	}
+
+	uint32_t Serialize(std::string& buffer) const override
+	{
+		Align(buffer, sizeof(uint32_t));
+		const std::size_t position(buffer.size());
+		Put(buffer, static_cast<uint32_t>(elements.size()));
+		const std::size_t firstSlot(buffer.size());
+		buffer.resize(buffer.size() + elements.size() * sizeof(uint32_t), '\0');
+
+		for (std::size_t i = 0; i < elements.size(); ++i)
+		{
+			const std::size_t slot(firstSlot + i * sizeof(uint32_t));
+			const uint32_t elementPosition(elements[i]->Serialize(buffer));
+			Patch(buffer, slot, static_cast<uint32_t>(elementPosition - slot));
+		}
+
+		return static_cast<uint32_t>(position);
+	}
+
+private:
+	std::vector<std::unique_ptr<FlatNode>> elements;
+};
+
+// Vector of 8-byte aligned structs, given as raw little-endian bytes
+class FlatStructVector : public FlatNode
+{
+public:
+	FlatStructVector(const std::string& bytes, const uint32_t& count) : bytes(bytes), count(count) {}
+
+	uint32_t Serialize(std::string& buffer) const override
+	{
+		// The length prefix sits immediately before the (8-byte aligned) elements
+		Align(buffer, sizeof(uint32_t));
+		if ((buffer.size() + sizeof(uint32_t)) % sizeof(int64_t) != 0)
+			Put(buffer, static_cast<uint32_t>(0));
+
+		const std::size_t position(buffer.size());
+		Put(buffer, count);
+		buffer.append(bytes);
+		return static_cast<uint32_t>(position);
+	}
+
+private:
+	const std::string bytes;
+	const uint32_t count;
+};
+
+class FlatString : public FlatNode
+{
+public:
+	explicit FlatString(const std::string& value) : value(value) {}
+
+	uint32_t Serialize(std::string& buffer) const override
+	{
+		Align(buffer, sizeof(uint32_t));
+		const std::size_t position(buffer.size());
+		Put(buffer, static_cast<uint32_t>(value.size()));
+		buffer.append(value);
+		buffer.push_back('\0');
+		return static_cast<uint32_t>(position);
+	}
+
+private:
+	const std::string value;
+};
+
+std::string Finish(const FlatNode& root)
+{
+	std::string buffer;
+	Put(buffer, static_cast<uint32_t>(0));
+	Patch(buffer, 0, root.Serialize(buffer));
+	Align(buffer, sizeof(int64_t));
+	return buffer;
+}
+
+// Enumerations from the Arrow flatbuffer schemas
+const int16_t metadataVersionV5(4);
+const uint8_t messageHeaderSchema(1);
+const uint8_t messageHeaderRecordBatch(3);
+const uint8_t typeFloatingPoint(3);
+const uint8_t typeTimestamp(10);
+const int16_t precisionDouble(2);
+const int16_t timeUnitSecond(0);
+const int16_t endiannessLittle(0);
+
+std::unique_ptr<FlatNode> MakeField(const std::string& name, const uint8_t& typeType, std::unique_ptr<FlatNode> type)
+{
+	auto field(std::make_unique<FlatTable>());
+	field->AddChild(0, std::make_unique<FlatString>(name));
+	field->AddScalar(1, static_cast<uint8_t>(0));// Not nullable
+	field->AddScalar(2, typeType);
+	field->AddChild(3, std::move(type));
+	field->AddChild(5, std::make_unique<FlatVector>());// No children
+	return field;
+}
+
+std::unique_ptr<FlatNode> MakeSchema(const std::string& timeColumnName, const std::vector<std::string>& valueColumnNames)
+{
+	auto fields(std::make_unique<FlatVector>());
+
+	auto timestamp(std::make_unique<FlatTable>());
+	timestamp->AddScalar(0, timeUnitSecond);
+	timestamp->AddChild(1, std::make_unique<FlatString>("UTC"));
+	fields->Add(MakeField(timeColumnName, typeTimestamp, std::move(timestamp)));
+
+	for (const auto& name : valueColumnNames)
+	{
+		auto floatingPoint(std::make_unique<FlatTable>());
+		floatingPoint->AddScalar(0, precisionDouble);
+		fields->Add(MakeField(name, typeFloatingPoint, std::move(floatingPoint)));
+	}
+
+	auto schema(std::make_unique<FlatTable>());
+	schema->AddScalar(0, endiannessLittle);
+	schema->AddChild(1, std::move(fields));
+	return schema;
+}
+
+std::unique_ptr<FlatNode> MakeMessage(const uint8_t& headerType, std::unique_ptr<FlatNode> header, const int64_t& bodyLength)
+{
+	auto message(std::make_unique<FlatTable>());
+	message->AddScalar(0, metadataVersionV5);
+	message->AddScalar(1, headerType);
+	message->AddChild(2, std::move(header));
+	message->AddScalar(3, bodyLength);
+	return message;
+}
+
+}// namespace
+
+const std::size_t ArrowFileWriter::rowsPerBatch(64 * 1024);
+
+ArrowFileWriter::ArrowFileWriter(const std::string& fileName, const std::string& timeColumnName,
+	const std::vector<std::string>& valueColumnNames, UString::OStream& log) : fileName(fileName),
+	timeColumnName(timeColumnName), valueColumnNames(valueColumnNames), log(log), file(fileName, std::ios::binary | std::ios::trunc),
+	values(valueColumnNames.size())
+{
+	if (!file.is_open())
+	{
+		log << "Failed to open '" << fileName << "' for output" << std::endl;
+		return;
+	}
+
+	times.reserve(rowsPerBatch);
+	for (auto& column : values)
+		column.reserve(rowsPerBatch);
+
+	ok = true;
+	Block schemaBlock;
+	ok = WriteBytes(std::string("ARROW1\0\0", 8)) && WriteMessage(BuildSchemaMessage(), std::string(), schemaBlock);
+}
+
+bool ArrowFileWriter::AddRow(const int64_t& time, const std::vector<double>& rowValues)
+{
+	if (!ok || rowValues.size() != values.size())
+		return false;
+
+	times.push_back(time);
+	for (std::size_t i = 0; i < values.size(); ++i)
+		values[i].push_back(rowValues[i]);
+
+	if (times.size() == rowsPerBatch)
+		return WriteBatch();
+	return true;
+}
+
+bool ArrowFileWriter::Close()
+{
+	if (!ok)
+		return false;
+
+	if (!times.empty() && !WriteBatch())
+		return false;
+
+	std::string trailer;
+	Put(trailer, static_cast<uint32_t>(0xFFFFFFFF));// End-of-stream marker
+	Put(trailer, static_cast<int32_t>(0));
+
+	const std::string footer(BuildFooter());
+	trailer.append(footer);
+	Put(trailer, static_cast<int32_t>(footer.size()));
+	trailer.append("ARROW1");
+
+	ok = WriteBytes(trailer);
+	file.close();
+	if (file.fail())
+	{
+		log << "Failed to finish writing '" << fileName << "'" << std::endl;
+		ok = false;
+	}
+
+	return ok;
+}
+
+bool ArrowFileWriter::WriteBatch()
+{
+	// Each column has an (empty) validity buffer followed by its values; every length is a multiple of 8
+	std::string body;
+	body.reserve(times.size() * sizeof(int64_t) * (values.size() + 1));
+	body.append(reinterpret_cast<const char*>(times.data()), times.size() * sizeof(int64_t));
+	for (const auto& column : values)
+		body.append(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(double));
+
+	Block block;
+	if (!WriteMessage(BuildRecordBatchMessage(static_cast<int64_t>(body.size())), body, block))
+		return false;
+
+	recordBatches.push_back(block);
+	times.clear();
+	for (auto& column : values)
+		column.clear();
+
+	return true;
+}
+
+bool ArrowFileWriter::WriteMessage(const std::string& metadata, const std::string& body, Block& block)
+{
+	block.offset = file.tellp();
+	block.metadataLength = static_cast<int32_t>(2 * sizeof(int32_t) + metadata.size());
+	block.bodyLength = static_cast<int64_t>(body.size());
+
+	std::string prefix;
+	Put(prefix, static_cast<uint32_t>(0xFFFFFFFF));// Continuation marker
+	Put(prefix, static_cast<int32_t>(metadata.size()));
+	return WriteBytes(prefix) && WriteBytes(metadata) && WriteBytes(body);
+}
+
+bool ArrowFileWriter::WriteBytes(const std::string& bytes)
+{
+	if (!file.write(bytes.data(), bytes.size()))
+	{
+		log << "Failed to write to '" << fileName << "'" << std::endl;
+		ok = false;
+	}
+
+	return ok;
+}
+
+std::string ArrowFileWriter::BuildSchemaMessage() const
+{
+	return Finish(*MakeMessage(messageHeaderSchema, MakeSchema(timeColumnName, valueColumnNames), 0));
+}
+
+std::string ArrowFileWriter::BuildRecordBatchMessage(const int64_t& bodyLength) const
+{
+	const int64_t rowCount(static_cast<int64_t>(times.size()));
+	const uint32_t columnCount(static_cast<uint32_t>(values.size() + 1));
+
+	std::string nodes;
+	std::string buffers;
+	int64_t offset(0);
+	for (uint32_t i = 0; i < columnCount; ++i)
+	{
+		Put(nodes, rowCount);
+		Put(nodes, static_cast<int64_t>(0));// Null count
+
+		Put(buffers, offset);// Validity
+		Put(buffers, static_cast<int64_t>(0));
+		Put(buffers, offset);// Values
+		Put(buffers, static_cast<int64_t>(rowCount * sizeof(int64_t)));
+		offset += rowCount * sizeof(int64_t);
+	}
+
+	auto recordBatch(std::make_unique<FlatTable>());
+	recordBatch->AddScalar(0, rowCount);
+	recordBatch->AddChild(1, std::make_unique<FlatStructVector>(nodes, columnCount));
+	recordBatch->AddChild(2, std::make_unique<FlatStructVector>(buffers, 2 * columnCount));
+	return Finish(*MakeMessage(messageHeaderRecordBatch, std::move(recordBatch), bodyLength));
+}
+
+std::string ArrowFileWriter::BuildFooter() const
+{
+	std::string blocks;
+	for (const auto& block : recordBatches)
+	{
+		Put(blocks, block.offset);
+		Put(blocks, block.metadataLength);
+		Put(blocks, static_cast<int32_t>(0));// Padding
+		Put(blocks, block.bodyLength);
+	}
+
+	auto footer(std::make_unique<FlatTable>());
+	footer->AddScalar(0, metadataVersionV5);
+	footer->AddChild(1, MakeSchema(timeColumnName, valueColumnNames));
+	footer->AddChild(2, std::make_unique<FlatStructVector>(std::string(), 0));
+	footer->AddChild(3, std::make_unique<FlatStructVector>(blocks, static_cast<uint32_t>(recordBatches.size())));
+	return Finish(*footer);
+}
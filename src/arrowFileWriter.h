@@ -0,0 +1,66 @@
+// File:  arrowFileWriter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Streaming writer for Arrow IPC (Feather V2) files of time series data.
+
+#ifndef ARROW_FILE_WRITER_H_
+#define ARROW_FILE_WRITER_H_
+
+// Local headers
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+// Writes a table whose first column is a UTC timestamp (int64 seconds) followed by any number
+// of non-nullable float64 columns.  Rows are buffered and written as record batches, so memory
+// use is bounded by the batch size regardless of how much data is exported.  The Arrow
+// metadata (flatbuffers) is encoded directly, so no Arrow library is needed.
+class ArrowFileWriter
+{
+public:
+	ArrowFileWriter(const std::string& fileName, const std::string& timeColumnName, const std::vector<std::string>& valueColumnNames, UString::OStream& log);
+
+	bool IsOK() const { return ok; }
+
+	bool AddRow(const int64_t& time, const std::vector<double>& values);
+
+	// Writes any buffered rows and the file footer; the file is incomplete until this succeeds
+	bool Close();
+
+private:
+	static const std::size_t rowsPerBatch;
+
+	const std::string fileName;
+	const std::string timeColumnName;
+	const std::vector<std::string> valueColumnNames;
+	UString::OStream& log;
+
+	std::ofstream file;
+	bool ok = false;
+
+	std::vector<int64_t> times;
+	std::vector<std::vector<double>> values;
+
+	struct Block
+	{
+		int64_t offset;
+		int32_t metadataLength;
+		int64_t bodyLength;
+	};
+
+	std::vector<Block> recordBatches;
+
+	bool WriteBatch();
+	bool WriteMessage(const std::string& metadata, const std::string& body, Block& block);
+	bool WriteBytes(const std::string& bytes);
+
+	std::string BuildSchemaMessage() const;
+	std::string BuildRecordBatchMessage(const int64_t& bodyLength) const;
+	std::string BuildFooter() const;
+};
+
+#endif// ARROW_FILE_WRITER_H_
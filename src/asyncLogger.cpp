@@ -0,0 +1,305 @@
+// File:  asyncLogger.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Stream-compatible logger that hands lines to a background writer thread.
+
+// Local headers
+#include "asyncLogger.h"
+#include "timestamp.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <filesystem>
+
+const std::size_t AsyncLogger::ringCapacity(1024);
+const std::chrono::milliseconds AsyncLogger::drainPeriod(100);
+const std::chrono::milliseconds AsyncLogger::maxFullRingWait(10);
+
+std::atomic<std::uint64_t> AsyncLogger::nextLoggerID(1);
+thread_local AsyncLogger::ThreadState AsyncLogger::threadState;
+
+AsyncLogger::AsyncLogger(const std::string& fileName, UString::OStream& console) : UString::OStream(&buffer),
+	loggerID(nextLoggerID++), buffer(*this), fileName(fileName), file(fileName, std::ios::app), console(console)
+{
+	std::error_code ec;
+	const auto existingSize(std::filesystem::file_size(fileName, ec));
+	if (!ec)
+		fileSize = static_cast<std::streamoff>(existingSize);
+
+	writerThread = std::thread(&AsyncLogger::WriterThreadEntry, this);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+	{
+		std::lock_guard<std::mutex> lock(drainMutex);
+		stopRequested = true;
+	}
+
+	drainCondition.notify_all();
+	writerThread.join();
+}
+
+bool AsyncLogger::ParseLevel(const std::string& name, Level& level)
+{
+	if (name == "ERROR")
+		level = Level::Error;
+	else if (name == "WARNING")
+		level = Level::Warning;
+	else if (name == "INFO")
+		level = Level::Info;
+	else
+		return false;
+
+	return true;
+}
+
+void AsyncLogger::SetRotation(const std::streamoff& maxFileSize, const unsigned int& filesToKeep)
+{
+	std::lock_guard<std::mutex> lock(drainMutex);
+	this->maxFileSize = maxFileSize;
+	this->filesToKeep = filesToKeep;
+}
+
+AsyncLogger::Buffer::int_type AsyncLogger::Buffer::overflow(int_type c)
+{
+	if (!traits_type::eq_int_type(c, traits_type::eof()))
+		owner.GetThreadLine().push_back(traits_type::to_char_type(c));
+	return traits_type::not_eof(c);
+}
+
+std::streamsize AsyncLogger::Buffer::xsputn(const Char* s, std::streamsize count)
+{
+	owner.GetThreadLine().append(s, static_cast<std::size_t>(count));
+	return count;
+}
+
+int AsyncLogger::Buffer::sync()
+{
+	owner.Commit();
+	return 0;
+}
+
+AsyncLogger::Ring& AsyncLogger::GetThreadRing()
+{
+	if (threadState.loggerID != loggerID)
+	{
+		std::lock_guard<std::mutex> lock(ringsMutex);
+		rings.push_back(std::make_unique<Ring>(ringCapacity));
+		threadState.loggerID = loggerID;
+		threadState.ring = rings.back().get();
+		threadState.line.clear();
+	}
+
+	return *threadState.ring;
+}
+
+UString::String& AsyncLogger::GetThreadLine()
+{
+	GetThreadRing();
+	return threadState.line;
+}
+
+AsyncLogger::Level AsyncLogger::GetLevel(const UString::String& text)
+{
+	static const UString::String errorPrefix(_T("ERROR:"));
+	static const UString::String warningPrefix(_T("Warning:"));
+	if (text.compare(0, errorPrefix.size(), errorPrefix) == 0)
+		return Level::Error;
+	else if (text.compare(0, warningPrefix.size(), warningPrefix) == 0)
+		return Level::Warning;
+	return Level::Info;
+}
+
+void AsyncLogger::Commit()
+{
+	UString::String& line(GetThreadLine());
+	if (line.empty())
+		return;
+
+	const Level level(GetLevel(line));
+	if (level < minimumLevel)
+	{
+		line.clear();
+		return;
+	}
+
+	Entry entry;
+	entry.time = std::chrono::system_clock::now();
+	entry.level = level;
+	entry.text.swap(line);
+	if (Push(entry))
+	{
+		// Push swapped in the slot's old (already cleared) string, so its capacity gets reused
+		line.swap(entry.text);
+		line.clear();
+	}
+
+	if (level == Level::Error)
+		drainCondition.notify_one();
+}
+
+void AsyncLogger::Defer(Formatter&& formatter)
+{
+	Entry entry;
+	entry.time = std::chrono::system_clock::now();
+	entry.level = Level::Info;
+	entry.formatter = std::move(formatter);
+	Push(entry);
+}
+
+bool AsyncLogger::Push(Entry& entry)
+{
+	Ring& ring(GetThreadRing());
+	const std::size_t tail(ring.tail.load(std::memory_order_relaxed));
+	std::size_t used(tail - ring.head.load(std::memory_order_acquire));
+	if (used == ring.entries.size())
+	{
+		// Give the writer a short chance to catch up, but never block a measurement thread for long
+		const auto deadline(std::chrono::steady_clock::now() + maxFullRingWait);
+		while (used == ring.entries.size() && std::chrono::steady_clock::now() < deadline)
+		{
+			drainCondition.notify_one();
+			std::this_thread::yield();
+			used = tail - ring.head.load(std::memory_order_acquire);
+		}
+
+		if (used == ring.entries.size())
+		{
+			droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+	}
+	else if (used == ring.entries.size() / 2)
+		drainCondition.notify_one();
+
+	Entry& slot(ring.entries[tail & (ring.entries.size() - 1)]);
+	slot.time = entry.time;
+	slot.sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+	slot.level = entry.level;
+	slot.text.swap(entry.text);
+	slot.formatter = std::move(entry.formatter);
+	ring.tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+void AsyncLogger::WriterThreadEntry()
+{
+	std::unique_lock<std::mutex> lock(drainMutex);
+	while (!stopRequested)
+	{
+		drainCondition.wait_for(lock, drainPeriod);
+		Drain();
+	}
+
+	Drain();
+}
+
+// Call with drainMutex held
+void AsyncLogger::Drain()
+{
+	std::vector<Entry*> pending;
+	std::vector<std::pair<Ring*, std::size_t>> tails;
+	{
+		std::lock_guard<std::mutex> lock(ringsMutex);
+		for (auto& ring : rings)
+		{
+			const std::size_t tail(ring->tail.load(std::memory_order_acquire));
+			for (std::size_t i = ring->head.load(std::memory_order_relaxed); i < tail; ++i)
+				pending.push_back(&ring->entries[i & (ring->entries.size() - 1)]);
+			tails.push_back(std::make_pair(ring.get(), tail));
+		}
+	}
+
+	if (pending.empty() && droppedCount.load(std::memory_order_relaxed) == 0)
+		return;
+
+	// Sequence numbers keep each ring in FIFO order even if the wall clock steps back
+	std::sort(pending.begin(), pending.end(), [](const Entry* a, const Entry* b)
+	{
+		return a->sequence < b->sequence;
+	});
+
+	for (auto& entry : pending)
+	{
+		if (entry->formatter)
+		{
+			UString::OStringStream ss;
+			entry->formatter(ss);
+			entry->text = ss.str();
+			entry->level = GetLevel(entry->text);
+			entry->formatter = nullptr;
+		}
+
+		if (entry->level >= minimumLevel)
+			Write(*entry);
+
+		entry->text.clear();
+	}
+
+	// Slots are only handed back to the producers once every entry in the batch is done with
+	for (const auto& t : tails)
+		t.first->head.store(t.second, std::memory_order_release);
+
+	const std::size_t dropped(droppedCount.exchange(0, std::memory_order_relaxed));
+	if (dropped > 0)
+	{
+		Entry entry;
+		entry.time = std::chrono::system_clock::now();
+		entry.level = Level::Warning;
+		UString::OStringStream ss;
+		ss << "Warning:  Dropped " << dropped << " log messages because the log buffer was full";
+		entry.text = ss.str();
+		Write(entry);
+	}
+
+	file.flush();
+	console.flush();
+}
+
+void AsyncLogger::Write(const Entry& entry)
+{
+	char timeString[Timestamp::logBufferSize + 2];
+	std::size_t length(Timestamp::FormatLogTime(entry.time, timeString));
+	timeString[length++] = ' ';
+	timeString[length++] = ' ';
+	timeString[length] = '\0';
+
+	const bool needsNewline(entry.text.empty() || entry.text.back() != _T('\n'));
+	file << timeString << entry.text;
+	console << timeString << entry.text;
+	if (needsNewline)
+	{
+		file << _T('\n');
+		console << _T('\n');
+	}
+
+	fileSize += static_cast<std::streamoff>(length + entry.text.size() + (needsNewline ? 1 : 0));
+	RotateIfNeeded();
+}
+
+void AsyncLogger::RotateIfNeeded()
+{
+	if (maxFileSize == 0 || fileSize < maxFileSize)
+		return;
+
+	file.close();
+	std::error_code ec;
+	if (filesToKeep == 0)
+		std::filesystem::remove(fileName, ec);
+	else
+	{
+		for (unsigned int i = filesToKeep - 1; i > 0; --i)
+		{
+			const std::string from(fileName + '.' + std::to_string(i));
+			if (std::filesystem::exists(from, ec))
+				std::filesystem::rename(from, fileName + '.' + std::to_string(i + 1), ec);
+		}
+		std::filesystem::rename(fileName, fileName + ".1", ec);
+	}
+
+	file.open(fileName, std::ios::trunc);
+	fileSize = 0;
+	if (!file.is_open())
+		console << "ERROR:  Failed to reopen '" << fileName.c_str() << "' after rotation" << std::endl;
+}
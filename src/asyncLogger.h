@@ -0,0 +1,153 @@
+// File:  asyncLogger.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Stream-compatible logger that hands lines to a background writer thread.
+
+#ifndef ASYNC_LOGGER_H_
+#define ASYNC_LOGGER_H_
+
+// Local headers
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <streambuf>
+#include <cstdint>
+
+// Lines written with the usual "log << ... << std::endl" are collected per thread and committed
+// to that thread's lock-free ring on flush, so callers never wait on file or console I/O.  A
+// background thread merges the rings in time order, writes to the log file and console and
+// rotates the file by size.  Severity is taken from the "ERROR:" and "Warning:" prefixes.
+class AsyncLogger : public UString::OStream
+{
+public:
+	AsyncLogger(const std::string& fileName, UString::OStream& console);
+	~AsyncLogger();
+
+	bool IsOK() const { return file.is_open(); }
+	const std::string& GetFileName() const { return fileName; }
+
+	enum class Level
+	{
+		Info,
+		Warning,
+		Error
+	};
+
+	static bool ParseLevel(const std::string& name, Level& level);
+
+	void SetMinimumLevel(const Level& level) { minimumLevel = level; }
+	void SetRotation(const std::streamoff& maxFileSize, const unsigned int& filesToKeep);
+
+	typedef std::function<void(UString::OStream&)> Formatter;
+
+	// Formatting (and level parsing) is done on the writer thread; the formatter must capture by value
+	void Defer(Formatter&& formatter);
+
+private:
+	typedef UString::String::value_type Char;
+
+	static const std::size_t ringCapacity;// Must be a power of two
+	static const std::chrono::milliseconds drainPeriod;
+	static const std::chrono::milliseconds maxFullRingWait;
+
+	class Buffer : public std::basic_streambuf<Char>
+	{
+	public:
+		explicit Buffer(AsyncLogger& owner) : owner(owner) {}
+
+	protected:
+		int_type overflow(int_type c) override;
+		std::streamsize xsputn(const Char* s, std::streamsize count) override;
+		int sync() override;
+
+	private:
+		AsyncLogger& owner;
+	};
+
+	struct Entry
+	{
+		std::chrono::system_clock::time_point time;
+		std::uint64_t sequence;// Orders entries across rings; unaffected by wall-clock steps
+		Level level;
+		UString::String text;
+		Formatter formatter;
+	};
+
+	// Single producer (the owning thread), single consumer (the writer thread)
+	struct Ring
+	{
+		explicit Ring(const std::size_t& capacity) : entries(capacity) {}
+
+		std::vector<Entry> entries;
+		alignas(64) std::atomic<std::size_t> head = 0;// Next entry to read
+		alignas(64) std::atomic<std::size_t> tail = 0;// Next entry to write
+	};
+
+	struct ThreadState
+	{
+		std::uint64_t loggerID = 0;
+		Ring* ring = nullptr;
+		UString::String line;
+	};
+
+	static std::atomic<std::uint64_t> nextLoggerID;
+	std::atomic<std::uint64_t> nextSequence = 0;
+	static thread_local ThreadState threadState;
+
+	const std::uint64_t loggerID;
+	Buffer buffer;
+
+	const std::string fileName;
+	UString::OFStream file;
+	UString::OStream& console;
+	std::streamoff fileSize = 0;
+	std::streamoff maxFileSize = 0;// Zero disables rotation
+	unsigned int filesToKeep = 0;
+
+	std::atomic<Level> minimumLevel = Level::Info;
+	std::atomic<std::size_t> droppedCount = 0;
+
+	std::mutex ringsMutex;
+	std::vector<std::unique_ptr<Ring>> rings;
+
+	std::mutex drainMutex;
+	std::condition_variable drainCondition;
+	bool stopRequested = false;
+	std::thread writerThread;
+
+	UString::String& GetThreadLine();
+	Ring& GetThreadRing();
+	void Commit();
+	bool Push(Entry& entry);
+
+	static Level GetLevel(const UString::String& text);
+
+	void WriterThreadEntry();
+	void Drain();
+	void Write(const Entry& entry);
+	void RotateIfNeeded();
+};
+
+// Uses deferred formatting when the stream is an AsyncLogger; otherwise formats immediately
+template<typename Formatter>
+void LogDeferred(UString::OStream& log, Formatter&& formatter)
+{
+	if (auto asyncLog = dynamic_cast<AsyncLogger*>(&log))
+		asyncLog->Defer(std::forward<Formatter>(formatter));
+	else
+	{
+		formatter(log);
+		log << std::endl;
+	}
+}
+
+#endif// ASYNC_LOGGER_H_
@@ -0,0 +1,112 @@
+// File:  configFileWatcher.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Blocks until a file is modified (uses inotify).
+
+// Local headers
+#include "configFileWatcher.h"
+
+// Standard C++ headers
+#include <filesystem>
+#include <cstring>
+#include <cerrno>
+
+// *nix headers
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+
+const int ConfigFileWatcher::settleTime(250);
+
+ConfigFileWatcher::ConfigFileWatcher(const std::string& fileName, UString::OStream& log) : log(log)
+{
+	// Watch the directory rather than the file so we also see editors that save by renaming a new file over the old one
+	const std::filesystem::path path(std::filesystem::absolute(fileName));
+	watchedName = path.filename().string();
+
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd < 0)
+	{
+		log << "Failed to initialize inotify:  " << std::strerror(errno) << std::endl;
+		return;
+	}
+
+	watchDescriptor = inotify_add_watch(inotifyFd, path.parent_path().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if (watchDescriptor < 0)
+		log << "Failed to watch '" << path.parent_path().string() << "':  " << std::strerror(errno) << std::endl;
+
+	stopFd = eventfd(0, EFD_CLOEXEC);
+	if (stopFd < 0)
+		log << "Failed to create stop event:  " << std::strerror(errno) << std::endl;
+}
+
+ConfigFileWatcher::~ConfigFileWatcher()
+{
+	if (inotifyFd >= 0)
+		close(inotifyFd);
+	if (stopFd >= 0)
+		close(stopFd);
+}
+
+void ConfigFileWatcher::Stop()
+{
+	const uint64_t one(1);
+	if (write(stopFd, &one, sizeof(one)) != sizeof(one))
+		log << "Failed to signal config file watcher to stop" << std::endl;
+}
+
+bool ConfigFileWatcher::WaitForChange()
+{
+	pollfd fds[2] = {};
+	fds[0].fd = inotifyFd;
+	fds[0].events = POLLIN;
+	fds[1].fd = stopFd;
+	fds[1].events = POLLIN;
+
+	bool fileChanged(false);
+	while (true)
+	{
+		// Once a change is seen, keep collecting events until the file has been quiet for a moment
+		const int result(poll(fds, 2, fileChanged ? settleTime : -1));
+		if (result < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			log << "Failed to poll for config file changes:  " << std::strerror(errno) << std::endl;
+			return false;
+		}
+
+		if (fds[1].revents & POLLIN)
+			return false;
+		else if (result == 0)
+			return true;
+
+		if (!ReadEvents(fileChanged))
+			return false;
+	}
+}
+
+bool ConfigFileWatcher::ReadEvents(bool& fileChanged)
+{
+	alignas(inotify_event) char buffer[4096];
+	while (true)
+	{
+		const ssize_t length(read(inotifyFd, buffer, sizeof(buffer)));
+		if (length < 0)
+		{
+			if (errno == EAGAIN)
+				return true;
+			log << "Failed to read inotify events:  " << std::strerror(errno) << std::endl;
+			return false;
+		}
+
+		for (ssize_t i = 0; i < length;)
+		{
+			const inotify_event* event(reinterpret_cast<const inotify_event*>(buffer + i));
+			if (event->len > 0 && watchedName == event->name)
+				fileChanged = true;
+			i += sizeof(inotify_event) + event->len;
+		}
+	}
+}
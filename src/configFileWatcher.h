@@ -0,0 +1,41 @@
+// File:  configFileWatcher.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Blocks until a file is modified (uses inotify).
+
+#ifndef CONFIG_FILE_WATCHER_H_
+#define CONFIG_FILE_WATCHER_H_
+
+// Local headers
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+
+class ConfigFileWatcher
+{
+public:
+	ConfigFileWatcher(const std::string& fileName, UString::OStream& log);
+	~ConfigFileWatcher();
+
+	bool IsOK() const { return watchDescriptor >= 0 && stopFd >= 0; }
+
+	// Returns true when the file has been rewritten, or false after Stop() is called
+	bool WaitForChange();
+	void Stop();
+
+private:
+	// Editors often write a file in several steps; changes within this window are reported once
+	static const int settleTime;// [ms]
+
+	UString::OStream& log;
+	std::string watchedName;
+
+	int inotifyFd = -1;
+	int watchDescriptor = -1;
+	int stopFd = -1;
+
+	bool ReadEvents(bool& fileChanged);
+};
+
+#endif// CONFIG_FILE_WATCHER_H_
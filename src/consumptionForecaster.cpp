@@ -0,0 +1,124 @@
+// File:  consumptionForecaster.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Recursive estimate of oil consumption as a function of outside temperature.
+
+// Local headers
+#include "consumptionForecaster.h"
+
+// Standard C++ headers
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+const double ConsumptionForecaster::baseTemperature(65.0);
+const double ConsumptionForecaster::forgettingFactor(0.995);// Roughly the last month of samples at a 4 hr period
+const double ConsumptionForecaster::residualSmoothing(0.05);
+const double ConsumptionForecaster::temperatureTimeConstant(3.0);
+const double ConsumptionForecaster::minIntervalForUpdate(1.0 / 48.0);
+const unsigned int ConsumptionForecaster::minUpdatesForForecast(10);
+
+ConsumptionForecaster::ConsumptionForecaster() : theta(Eigen::Vector2d::Zero()), p(Eigen::Matrix2d::Identity() * 1.0e3), residualVariance(0.0)
+{
+}
+
+void ConsumptionForecaster::AddTemperature(const TimePoint& t, const double& temperature)
+{
+	const double hdd(HeatingDegrees(temperature));
+	intervalHDDSum += hdd;
+	++intervalHDDCount;
+
+	if (!haveTemperature)
+		smoothedHDD = hdd;
+	else
+	{
+		const double alpha(1.0 - exp(-std::max(0.0, DaysBetween(lastTemperatureTime, t)) / temperatureTimeConstant));
+		smoothedHDD += alpha * (hdd - smoothedHDD);
+	}
+
+	haveTemperature = true;
+	lastTemperatureTime = t;
+}
+
+void ConsumptionForecaster::AddVolume(const TimePoint& t, const double& volume, const double& refillVolume)
+{
+	if (!haveVolume || volume > lastVolume + refillVolume)
+	{
+		// Nothing to difference against (start-up or refill), so just restart the interval
+		haveVolume = true;
+		lastVolumeTime = t;
+		lastVolume = volume;
+		intervalHDDSum = 0.0;
+		intervalHDDCount = 0;
+		return;
+	}
+
+	const double days(DaysBetween(lastVolumeTime, t));
+	if (days < minIntervalForUpdate)
+		return;// Too short for the measurement noise to average out; keep accumulating
+
+	const double intervalHDD(intervalHDDCount > 0 ? intervalHDDSum / intervalHDDCount : smoothedHDD);
+	Update(Eigen::Vector2d(1.0, intervalHDD), (lastVolume - volume) / days);
+
+	lastVolumeTime = t;
+	lastVolume = volume;
+	intervalHDDSum = 0.0;
+	intervalHDDCount = 0;
+}
+
+void ConsumptionForecaster::Update(const Eigen::Vector2d& x, const double& rate)
+{
+	// Directional forgetting:  old information is discounted only along x, so a direction that
+	// isn't excited (e.g. heating demand all summer) keeps what it knew instead of its
+	// uncertainty growing without bound.  The information along x settles at
+	// forgettingFactor / (1 - forgettingFactor) samples, as with exponential forgetting.
+	const double residual(rate - x.dot(theta));
+	const Eigen::Vector2d px(p * x);
+	const double r(x.dot(px));
+	if (r > 0.0)
+	{
+		const double epsilon(forgettingFactor - (1.0 - forgettingFactor) / r);
+		p -= px * px.transpose() / (1.0 / epsilon + r);
+		p = 0.5 * (p + p.transpose());// Keep symmetric despite rounding
+	}
+
+	theta += p * x * residual;
+
+	if (updateCount == 0)
+		residualVariance = residual * residual;
+	else
+		residualVariance += residualSmoothing * (residual * residual - residualVariance);
+	++updateCount;
+}
+
+ConsumptionForecaster::Forecast ConsumptionForecaster::GetForecast(const double& volume) const
+{
+	const Eigen::Vector2d x(1.0, smoothedHDD);
+	const double rate(x.dot(theta));
+	const double rateStdDev(sqrt(std::max(0.0, x.dot(p * x) * residualVariance)));
+	const double z(1.96);
+
+	const auto daysAtRate([volume](const double& r)
+	{
+		if (r <= 0.0)
+			return std::numeric_limits<double>::infinity();
+		return std::max(0.0, volume) / r;
+	});
+
+	Forecast forecast;
+	forecast.consumptionRate = rate;
+	forecast.daysToEmpty = daysAtRate(rate);
+	forecast.lowerBound = daysAtRate(rate + z * rateStdDev);
+	forecast.upperBound = daysAtRate(rate - z * rateStdDev);
+	return forecast;
+}
+
+double ConsumptionForecaster::HeatingDegrees(const double& temperature)
+{
+	return std::max(0.0, baseTemperature - temperature);
+}
+
+double ConsumptionForecaster::DaysBetween(const TimePoint& a, const TimePoint& b)
+{
+	return std::chrono::duration<double, std::ratio<86400>>(b - a).count();
+}
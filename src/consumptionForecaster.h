@@ -0,0 +1,70 @@
+// File:  consumptionForecaster.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Recursive estimate of oil consumption as a function of outside temperature.
+
+#ifndef CONSUMPTION_FORECASTER_H_
+#define CONSUMPTION_FORECASTER_H_
+
+// Eigen headers
+#include <Eigen/Core>
+
+// Standard C++ headers
+#include <chrono>
+
+// Models consumption rate [gal/day] = base + k * HDD, where HDD = max(0, 65 deg F - T) is the
+// heating degree-day rate, and fits it by recursive least squares with directional forgetting.
+// Each sample costs a constant amount of work, and the model survives tank refills.
+class ConsumptionForecaster
+{
+public:
+	ConsumptionForecaster();
+
+	typedef std::chrono::system_clock::time_point TimePoint;
+
+	void AddTemperature(const TimePoint& t, const double& temperature);// [deg F]
+	// Increases larger than refillVolume [gal] are treated as a delivery and restart the interval
+	void AddVolume(const TimePoint& t, const double& volume, const double& refillVolume);// [gal]
+
+	struct Forecast
+	{
+		double daysToEmpty;// Infinite if no consumption is expected
+		double lowerBound;// 95% interval [days]
+		double upperBound;
+		double consumptionRate;// [gal/day]
+	};
+
+	bool IsReady() const { return updateCount >= minUpdatesForForecast; }
+	Forecast GetForecast(const double& volume) const;
+
+private:
+	static const double baseTemperature;// [deg F]
+	static const double forgettingFactor;
+	static const double residualSmoothing;
+	static const double temperatureTimeConstant;// [days]
+	static const double minIntervalForUpdate;// [days]
+	static const unsigned int minUpdatesForForecast;
+
+	Eigen::Vector2d theta;// Model coefficients (base rate, rate per HDD)
+	Eigen::Matrix2d p;// Inverse information matrix
+	double residualVariance;
+	unsigned int updateCount = 0;
+
+	bool haveVolume = false;
+	TimePoint lastVolumeTime;
+	double lastVolume;
+
+	// Heating demand since the last volume sample, and a smoothed value used for projection
+	double intervalHDDSum = 0.0;
+	unsigned int intervalHDDCount = 0;
+	bool haveTemperature = false;
+	TimePoint lastTemperatureTime;
+	double smoothedHDD = 0.0;
+
+	void Update(const Eigen::Vector2d& x, const double& rate);
+
+	static double HeatingDegrees(const double& temperature);
+	static double DaysBetween(const TimePoint& a, const TimePoint& b);
+};
+
+#endif// CONSUMPTION_FORECASTER_H_
@@ -0,0 +1,43 @@
+// File:  edgeEventPingSensor.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Ultrasonic distance sensor timed from kernel-stamped echo edges.
+
+// Local headers
+#include "edgeEventPingSensor.h"
+
+const std::chrono::microseconds EdgeEventPingSensor::echoStartTimeout(std::chrono::milliseconds(10));
+const std::chrono::microseconds EdgeEventPingSensor::maxEchoDuration(std::chrono::milliseconds(40));// HC-SR04 drops the echo line after ~38 ms if nothing returns
+const double EdgeEventPingSensor::microsecondsPerCentimeter(58.0);
+
+std::chrono::microseconds EdgeEventPingSensor::GetEchoDuration(const double& distance)
+{
+	return std::chrono::microseconds(static_cast<std::chrono::microseconds::rep>(distance * microsecondsPerCentimeter + 0.5));
+}
+
+bool EdgeEventPingSensor::GetDistance(double& distance, std::chrono::system_clock::time_point& edgeTime)
+{
+	if (!source->Trigger())
+		return false;
+
+	// Both edges are stamped by the kernel when the interrupt fires, so scheduling
+	// delays in waking this thread do not affect the measured pulse width
+	EdgeEventSource::Edge start;
+	do
+	{
+		if (!source->WaitForEdge(echoStartTimeout, start))
+			return false;
+	} while (!start.rising);
+
+	EdgeEventSource::Edge end;
+	if (!source->WaitForEdge(maxEchoDuration, end) || end.rising)
+		return false;
+
+	const double echoTime(std::chrono::duration<double, std::micro>(end.timestamp - start.timestamp).count());
+	if (echoTime <= 0.0 || echoTime >= std::chrono::duration<double, std::micro>(maxEchoDuration).count())
+		return false;
+
+	distance = echoTime / microsecondsPerCentimeter;
+	edgeTime = source->ToSystemTime(start.timestamp);
+	return true;
+}
@@ -0,0 +1,33 @@
+// File:  edgeEventPingSensor.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Ultrasonic distance sensor timed from kernel-stamped echo edges.
+
+#ifndef EDGE_EVENT_PING_SENSOR_H_
+#define EDGE_EVENT_PING_SENSOR_H_
+
+// Local headers
+#include "edgeEventSource.h"
+
+// Standard C++ headers
+#include <memory>
+
+class EdgeEventPingSensor
+{
+public:
+	explicit EdgeEventPingSensor(std::unique_ptr<EdgeEventSource> source) : source(std::move(source)) {}
+
+	// On success, edgeTime is set to the kernel's time stamp of the echo's rising edge
+	bool GetDistance(double& distance, std::chrono::system_clock::time_point& edgeTime);// [cm]
+
+	static std::chrono::microseconds GetEchoDuration(const double& distance);// [cm]
+
+private:
+	static const std::chrono::microseconds echoStartTimeout;
+	static const std::chrono::microseconds maxEchoDuration;
+	static const double microsecondsPerCentimeter;// Round trip
+
+	std::unique_ptr<EdgeEventSource> source;
+};
+
+#endif// EDGE_EVENT_PING_SENSOR_H_
@@ -0,0 +1,193 @@
+// File:  edgeEventSource.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Sources of time-stamped GPIO edge events for echo timing.
+
+// Local headers
+#include "edgeEventSource.h"
+
+// Standard C++ headers
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+
+// *nix headers
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+const std::chrono::microseconds GPIOEdgeEventSource::triggerPulseWidth(10);
+
+GPIOEdgeEventSource::GPIOEdgeEventSource(const std::string& chipPath, const int& triggerLine, const int& echoLine, UString::OStream& log) : log(log)
+{
+	const int chipFd(open(chipPath.c_str(), O_RDONLY | O_CLOEXEC));
+	if (chipFd < 0)
+	{
+		log << "Failed to open '" << chipPath << "':  " << std::strerror(errno) << std::endl;
+		return;
+	}
+
+	gpiohandle_request triggerRequest{};
+	triggerRequest.lineoffsets[0] = triggerLine;
+	triggerRequest.lines = 1;
+	triggerRequest.flags = GPIOHANDLE_REQUEST_OUTPUT;
+	triggerRequest.default_values[0] = 0;
+	std::strncpy(triggerRequest.consumer_label, "oilChecker trigger", sizeof(triggerRequest.consumer_label) - 1);
+	if (ioctl(chipFd, GPIO_GET_LINEHANDLE_IOCTL, &triggerRequest) < 0)
+		log << "Failed to request trigger line " << triggerLine << ":  " << std::strerror(errno) << std::endl;
+	else
+		triggerFd = triggerRequest.fd;
+
+	gpioevent_request echoRequest{};
+	echoRequest.lineoffset = echoLine;
+	echoRequest.handleflags = GPIOHANDLE_REQUEST_INPUT;
+	echoRequest.eventflags = GPIOEVENT_REQUEST_BOTH_EDGES;
+	std::strncpy(echoRequest.consumer_label, "oilChecker echo", sizeof(echoRequest.consumer_label) - 1);
+	if (ioctl(chipFd, GPIO_GET_LINEEVENT_IOCTL, &echoRequest) < 0)
+		log << "Failed to request edge events on echo line " << echoLine << ":  " << std::strerror(errno) << std::endl;
+	else
+	{
+		echoFd = echoRequest.fd;
+		fcntl(echoFd, F_SETFL, fcntl(echoFd, F_GETFL) | O_NONBLOCK);
+	}
+
+	close(chipFd);
+}
+
+GPIOEdgeEventSource::~GPIOEdgeEventSource()
+{
+	if (triggerFd >= 0)
+		close(triggerFd);
+	if (echoFd >= 0)
+		close(echoFd);
+}
+
+bool GPIOEdgeEventSource::Trigger()
+{
+	DiscardPendingEvents();
+
+	if (!SetTriggerLevel(true))
+		return false;
+	std::this_thread::sleep_for(triggerPulseWidth);// Sensor fires on the falling edge, so a longer pulse is harmless
+	return SetTriggerLevel(false);
+}
+
+bool GPIOEdgeEventSource::SetTriggerLevel(const bool& high)
+{
+	gpiohandle_data data{};
+	data.values[0] = high ? 1 : 0;
+	if (ioctl(triggerFd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0)
+	{
+		log << "Failed to set trigger line level:  " << std::strerror(errno) << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+void GPIOEdgeEventSource::DiscardPendingEvents()
+{
+	gpioevent_data event;
+	while (read(echoFd, &event, sizeof(event)) == sizeof(event))
+	{
+	}
+}
+
+bool GPIOEdgeEventSource::WaitForEdge(const std::chrono::microseconds& timeout, Edge& edge)
+{
+	const auto deadline(std::chrono::steady_clock::now() + timeout);
+	pollfd pfd{};
+	pfd.fd = echoFd;
+	pfd.events = POLLIN;
+
+	while (true)
+	{
+		gpioevent_data event;
+		if (read(echoFd, &event, sizeof(event)) == sizeof(event))
+		{
+			edge.rising = event.id == GPIOEVENT_EVENT_RISING_EDGE;
+			edge.timestamp = std::chrono::nanoseconds(event.timestamp);
+			return true;
+		}
+
+		const auto remaining(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()));
+		if (remaining.count() < 0)
+			return false;
+
+		// Round up so we never poll with a zero timeout while time remains
+		const int result(poll(&pfd, 1, static_cast<int>(remaining.count()) + 1));
+		if (result < 0 && errno != EINTR)
+		{
+			log << "Failed to poll echo line:  " << std::strerror(errno) << std::endl;
+			return false;
+		}
+		else if (result == 0)
+			return false;
+	}
+}
+
+// Kernels before 5.7 stamp edge events with CLOCK_REALTIME and later ones with CLOCK_MONOTONIC.
+// The two differ by decades, so whichever is closer to the timestamp must be the one in use.
+std::chrono::system_clock::time_point GPIOEdgeEventSource::ToSystemTime(const std::chrono::nanoseconds& timestamp) const
+{
+	timespec realtime, monotonic;
+	clock_gettime(CLOCK_REALTIME, &realtime);
+	clock_gettime(CLOCK_MONOTONIC, &monotonic);
+	const std::chrono::nanoseconds realtimeNow(std::chrono::seconds(realtime.tv_sec) + std::chrono::nanoseconds(realtime.tv_nsec));
+	const std::chrono::nanoseconds monotonicNow(std::chrono::seconds(monotonic.tv_sec) + std::chrono::nanoseconds(monotonic.tv_nsec));
+
+	std::chrono::nanoseconds sinceEpoch(timestamp);
+	if (std::llabs((timestamp - monotonicNow).count()) < std::llabs((timestamp - realtimeNow).count()))
+		sinceEpoch += realtimeNow - monotonicNow;
+
+	return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(sinceEpoch));
+}
+
+void SimulatedEdgeEventSource::QueueEcho(const std::chrono::microseconds& echoDuration, const std::chrono::microseconds& triggerToEchoDelay)
+{
+	scriptedEchoes.push_back(Echo{triggerToEchoDelay, echoDuration});
+}
+
+bool SimulatedEdgeEventSource::Trigger()
+{
+	pendingEdges.clear();
+	clock += std::chrono::milliseconds(100);
+
+	Echo echo{std::chrono::microseconds(450), steadyEchoDuration};
+	if (!scriptedEchoes.empty())
+	{
+		echo = scriptedEchoes.front();
+		scriptedEchoes.pop_front();
+	}
+
+	if (echo.duration.count() <= 0)
+		return true;
+
+	pendingEdges.push_back(Edge{true, clock + echo.delay});
+	pendingEdges.push_back(Edge{false, clock + echo.delay + echo.duration});
+	return true;
+}
+
+bool SimulatedEdgeEventSource::WaitForEdge(const std::chrono::microseconds& timeout, Edge& edge)
+{
+	if (pendingEdges.empty() || pendingEdges.front().timestamp > clock + timeout)
+	{
+		clock += timeout;
+		return false;
+	}
+
+	edge = pendingEdges.front();
+	pendingEdges.pop_front();
+	clock = edge.timestamp;
+	return true;
+}
+
+// The simulated clock starts when the source is created
+std::chrono::system_clock::time_point SimulatedEdgeEventSource::ToSystemTime(const std::chrono::nanoseconds& timestamp) const
+{
+	return start + std::chrono::duration_cast<std::chrono::system_clock::duration>(timestamp);
+}
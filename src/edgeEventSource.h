@@ -0,0 +1,92 @@
+// File:  edgeEventSource.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Sources of time-stamped GPIO edge events for echo timing.
+
+#ifndef EDGE_EVENT_SOURCE_H_
+#define EDGE_EVENT_SOURCE_H_
+
+// Local headers
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <chrono>
+#include <deque>
+#include <string>
+
+class EdgeEventSource
+{
+public:
+	virtual ~EdgeEventSource() = default;
+
+	struct Edge
+	{
+		bool rising;
+		std::chrono::nanoseconds timestamp;// Only differences between timestamps are meaningful
+	};
+
+	// Discards any stale events, then pulses the trigger output
+	virtual bool Trigger() = 0;
+
+	// Blocks (without spinning) until the next edge arrives or the timeout expires
+	virtual bool WaitForEdge(const std::chrono::microseconds& timeout, Edge& edge) = 0;
+
+	// Wall-clock time of an edge, for recording only; never use it to time the echo
+	virtual std::chrono::system_clock::time_point ToSystemTime(const std::chrono::nanoseconds& timestamp) const = 0;
+};
+
+// Uses the GPIO character device so the kernel records the time of each echo edge
+class GPIOEdgeEventSource : public EdgeEventSource
+{
+public:
+	GPIOEdgeEventSource(const std::string& chipPath, const int& triggerLine, const int& echoLine, UString::OStream& log);
+	~GPIOEdgeEventSource();
+
+	bool IsOK() const { return triggerFd >= 0 && echoFd >= 0; }
+
+	bool Trigger() override;
+	bool WaitForEdge(const std::chrono::microseconds& timeout, Edge& edge) override;
+	std::chrono::system_clock::time_point ToSystemTime(const std::chrono::nanoseconds& timestamp) const override;
+
+private:
+	static const std::chrono::microseconds triggerPulseWidth;
+
+	UString::OStream& log;
+
+	int triggerFd = -1;
+	int echoFd = -1;
+
+	bool SetTriggerLevel(const bool& high);
+	void DiscardPendingEvents();
+};
+
+// Replays a scripted sequence of echo durations so echo timing can be exercised off-hardware
+class SimulatedEdgeEventSource : public EdgeEventSource
+{
+public:
+	// A non-positive echo duration simulates a ping that never returns
+	void QueueEcho(const std::chrono::microseconds& echoDuration,
+		const std::chrono::microseconds& triggerToEchoDelay = std::chrono::microseconds(450));
+
+	// Used whenever the script is empty; zero (the default) means no echo
+	void SetSteadyEcho(const std::chrono::microseconds& echoDuration) { steadyEchoDuration = echoDuration; }
+
+	bool Trigger() override;
+	bool WaitForEdge(const std::chrono::microseconds& timeout, Edge& edge) override;
+	std::chrono::system_clock::time_point ToSystemTime(const std::chrono::nanoseconds& timestamp) const override;
+
+private:
+	struct Echo
+	{
+		std::chrono::microseconds delay;
+		std::chrono::microseconds duration;
+	};
+
+	std::deque<Echo> scriptedEchoes;
+	std::chrono::microseconds steadyEchoDuration = std::chrono::microseconds::zero();
+	std::deque<Edge> pendingEdges;
+	std::chrono::nanoseconds clock = std::chrono::nanoseconds::zero();
+	const std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
+};
+
+#endif// EDGE_EVENT_SOURCE_H_
@@ -0,0 +1,72 @@
+// File:  gzipUtilities.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Helpers for producing gzip-format data (uses zlib).
+
+// Local headers
+#include "gzipUtilities.h"
+
+// zlib headers
+#include <zlib.h>
+
+// Standard C++ headers
+#include <fstream>
+#include <vector>
+
+namespace GZipUtilities
+{
+
+namespace
+{
+
+const int gzipWindowBits(15 + 16);// Max. window plus 16 selects a gzip header instead of zlib
+const int memoryLevel(8);
+const std::size_t fileChunkSize(64 * 1024);
+
+}
+
+bool Compress(const std::string& input, std::string& output)
+{
+	z_stream stream{};
+	if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, gzipWindowBits, memoryLevel, Z_DEFAULT_STRATEGY) != Z_OK)
+		return false;
+
+	output.resize(deflateBound(&stream, input.size()));
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+	stream.avail_in = input.size();
+	stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+	stream.avail_out = output.size();
+
+	const int result(deflate(&stream, Z_FINISH));
+	output.resize(stream.total_out);
+	deflateEnd(&stream);
+	return result == Z_STREAM_END;
+}
+
+bool CompressFile(const std::string& inputFileName, const std::string& outputFileName)
+{
+	std::ifstream input(inputFileName, std::ios::binary);
+	if (!input.is_open())
+		return false;
+
+	gzFile output(gzopen(outputFileName.c_str(), "wb9"));
+	if (!output)
+		return false;
+
+	std::vector<char> buffer(fileChunkSize);
+	bool ok(true);
+	while (ok && input)
+	{
+		input.read(buffer.data(), buffer.size());
+		const std::streamsize count(input.gcount());
+		if (count > 0 && gzwrite(output, buffer.data(), static_cast<unsigned int>(count)) != count)
+			ok = false;
+	}
+
+	if (input.bad())
+		ok = false;
+
+	return gzclose(output) == Z_OK && ok;
+}
+
+}// namespace GZipUtilities
@@ -0,0 +1,20 @@
+// File:  gzipUtilities.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Helpers for producing gzip-format data (uses zlib).
+
+#ifndef GZIP_UTILITIES_H_
+#define GZIP_UTILITIES_H_
+
+// Standard C++ headers
+#include <string>
+
+namespace GZipUtilities
+{
+	bool Compress(const std::string& input, std::string& output);
+
+	// Streams the file through a fixed-size buffer, so memory use does not depend on file size
+	bool CompressFile(const std::string& inputFileName, const std::string& outputFileName);
+}
+
+#endif// GZIP_UTILITIES_H_
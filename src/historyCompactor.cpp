@@ -0,0 +1,427 @@
+// File:  historyCompactor.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Background downsampling and removal of old log archives to bound disk usage.
+
+// Local headers
+#include "historyCompactor.h"
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <set>
+
+// *nix headers
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+const std::chrono::minutes HistoryCompactor::startupDelay(10);
+const std::chrono::hours HistoryCompactor::checkPeriod(6);
+const std::chrono::seconds HistoryCompactor::stepDelay(5);
+const std::string HistoryCompactor::hourlySuffix(".hourly");
+const std::string HistoryCompactor::dailySuffix(".daily");
+
+HistoryCompactor::HistoryCompactor(const LiveConfig& liveConfig, ArchiveCatalog& catalog, const std::vector<std::string>& unmanagedFilePrefixes,
+	const PendingCheck& isRotationPending, const ArchiveCatalog::TimeParser& parseTime, const TimeFormatter& formatTime, UString::OStream& log)
+	: liveConfig(liveConfig), catalog(catalog), unmanagedFilePrefixes(unmanagedFilePrefixes), isRotationPending(isRotationPending),
+	parseTime(parseTime), formatTime(formatTime), log(log)
+{
+}
+
+void HistoryCompactor::Run()
+{
+	SetIdlePriority(log);
+
+	// Stay out of the way while the logs are read at startup
+	if (!Pause(startupDelay))
+		return;
+
+	do
+	{
+		Compact();
+	} while (Pause(checkPeriod));
+}
+
+void HistoryCompactor::Stop()
+{
+	std::lock_guard<std::mutex> lock(stopMutex);
+	stopRequested = true;
+	stopCondition.notify_all();
+}
+
+bool HistoryCompactor::Pause(const std::chrono::steady_clock::duration& duration)
+{
+	std::unique_lock<std::mutex> lock(stopMutex);
+	return !stopCondition.wait_for(lock, duration, [this]() { return stopRequested.load(); });
+}
+
+void HistoryCompactor::Compact()
+{
+	const RetentionConfig config(liveConfig.Get().retention);
+	const ArchiveCatalog::EpochSeconds now(std::chrono::duration_cast<std::chrono::seconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+	const ArchiveCatalog::EpochSeconds secondsPerDay(86400);
+
+	for (const auto& candidate : GetCandidates())
+	{
+		const bool dailyDue(config.hourlyDays > 0 && candidate.archive.lastTime < now - config.hourlyDays * secondsPerDay);
+		const bool hourlyDue(config.rawDays > 0 && candidate.archive.lastTime < now - config.rawDays * secondsPerDay);
+
+		Tier target(candidate.tier);
+		// Raw archives are kept forever if their retention is zero, even when hourly archives are reduced
+		if (candidate.tier != Tier::Daily && dailyDue && (candidate.tier == Tier::Hourly || config.rawDays > 0))
+			target = Tier::Daily;
+		else if (candidate.tier == Tier::Raw && hourlyDue)
+			target = Tier::Hourly;
+
+		if (target == candidate.tier)
+			continue;
+
+		Downsample(candidate, target);
+		if (!Pause(stepDelay))
+			return;
+	}
+
+	if (config.diskBudget > 0)
+		EnforceBudget(static_cast<std::uintmax_t>(config.diskBudget) * 1024 * 1024);
+}
+
+void HistoryCompactor::EnforceBudget(const std::uintmax_t& budget)
+{
+	std::vector<std::string> failed;
+	std::uintmax_t size;
+	while ((size = GetHistorySize()) > budget)
+	{
+		auto candidates(GetCandidates());
+		candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&failed](const Candidate& c)
+		{
+			return std::find(failed.begin(), failed.end(), c.archive.fileName) != failed.end();
+		}), candidates.end());
+
+		if (RemoveStaleCompressedCopy(candidates))
+			continue;
+
+		std::uintmax_t reclaimable(0);
+		for (const auto& candidate : candidates)
+			reclaimable += GetArchiveSize(candidate);
+
+		if (size - std::min(size, reclaimable) > budget)
+		{
+			log << "Warning:  History uses " << size / 1024 << " kB, exceeding the budget of " << budget / 1024
+				<< " kB, but removing every archive would not be enough; archives were left in place" << std::endl;
+			return;
+		}
+
+		// Move the oldest archive of the lowest tier along; with only daily archives left, delete the oldest
+		auto next(candidates.end());
+		for (const auto& tier : { Tier::Raw, Tier::Hourly, Tier::Daily })
+		{
+			next = std::find_if(candidates.begin(), candidates.end(), [&tier](const Candidate& c) { return c.tier == tier; });
+			if (next != candidates.end())
+				break;
+		}
+
+		if (next == candidates.end())
+		{
+			log << "Warning:  History uses " << size / 1024 << " kB, exceeding the budget of " << budget / 1024
+				<< " kB, but no archives are left to compact" << std::endl;
+			return;
+		}
+
+		bool ok;
+		if (next->tier == Tier::Daily)
+		{
+			log << "Warning:  Deleting '" << next->archive.fileName << "' to stay within the history disk budget" << std::endl;
+			catalog.RemoveArchive(next->series, next->archive.fileName);
+			std::error_code ec;
+			ok = std::filesystem::remove(next->archive.fileName, ec);
+		}
+		else
+			ok = Downsample(*next, next->tier == Tier::Raw ? Tier::Hourly : Tier::Daily);
+
+		if (!ok)
+			failed.push_back(next->archive.fileName);
+
+		if (!Pause(stepDelay))
+			return;
+	}
+}
+
+// Compressed copies are left behind only when emailing a rotated log gave up; the
+// uncompressed archive is still present, so these are the cheapest space to reclaim
+bool HistoryCompactor::RemoveStaleCompressedCopy(const std::vector<Candidate>& candidates)
+{
+	const auto staleAge(std::chrono::hours(24));// Don't pull the attachment out from under a pending retry
+	for (const auto& candidate : candidates)
+	{
+		if (candidate.tier != Tier::Raw)
+			continue;
+
+		const std::string compressedFileName(candidate.archive.fileName + ".gz");
+		std::error_code ec;
+		const auto modified(std::filesystem::last_write_time(compressedFileName, ec));
+		if (ec || std::filesystem::file_time_type::clock::now() - modified < staleAge)
+			continue;
+
+		if (std::filesystem::remove(compressedFileName, ec))
+		{
+			log << "Removed '" << compressedFileName << "' to stay within the history disk budget" << std::endl;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+std::vector<HistoryCompactor::Candidate> HistoryCompactor::GetCandidates() const
+{
+	std::vector<Candidate> candidates;
+	for (const auto& series : { ArchiveCatalog::Series::Oil, ArchiveCatalog::Series::Temperature })
+	{
+		for (const auto& archive : catalog.List(series))
+		{
+			// The rotator may still be compressing or emailing the raw archive
+			if (!isRotationPending(archive.fileName))
+				candidates.push_back(Candidate{series, archive, GetTier(archive.fileName)});
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+	{
+		return a.archive.lastTime < b.archive.lastTime;
+	});
+
+	return candidates;
+}
+
+std::uintmax_t HistoryCompactor::GetHistorySize() const
+{
+	std::uintmax_t size(0);
+	std::set<std::filesystem::path> counted;
+	const auto addSize([&size, &counted](const std::filesystem::path& path)
+	{
+		if (!counted.insert(path.lexically_normal()).second)
+			return;
+
+		std::error_code ec;
+		const auto fileSize(std::filesystem::file_size(path, ec));
+		if (!ec)
+			size += fileSize;
+	});
+
+	for (const auto& series : { ArchiveCatalog::Series::Oil, ArchiveCatalog::Series::Temperature })
+	{
+		for (const auto& archive : catalog.List(series))
+		{
+			addSize(archive.fileName);
+			if (GetTier(archive.fileName) == Tier::Raw)
+				addSize(archive.fileName + ".gz");
+		}
+	}
+
+	for (const auto& prefix : unmanagedFilePrefixes)
+	{
+		const std::filesystem::path prefixPath(prefix);
+		const std::filesystem::path directory(prefixPath.has_parent_path() ? prefixPath.parent_path() : std::filesystem::path("."));
+		const std::string namePrefix(prefixPath.filename().string());
+
+		std::error_code ec;
+		for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+		{
+			const std::string name(it->path().filename().string());
+			if (name.compare(0, namePrefix.size(), namePrefix) == 0 && it->is_regular_file(ec))
+				addSize(prefixPath.has_parent_path() ? it->path() : std::filesystem::path(name));
+		}
+	}
+
+	return size;
+}
+
+std::uintmax_t HistoryCompactor::GetArchiveSize(const Candidate& candidate)
+{
+	std::uintmax_t size(0);
+	std::error_code ec;
+	const auto fileSize(std::filesystem::file_size(candidate.archive.fileName, ec));
+	if (!ec)
+		size += fileSize;
+
+	if (candidate.tier == Tier::Raw)
+	{
+		const auto compressedSize(std::filesystem::file_size(candidate.archive.fileName + ".gz", ec));
+		if (!ec)
+			size += compressedSize;
+	}
+
+	return size;
+}
+
+bool HistoryCompactor::Downsample(const Candidate& candidate, const Tier& target)
+{
+	const std::string& inputFileName(candidate.archive.fileName);
+	const std::string outputFileName(GetBaseName(inputFileName) + (target == Tier::Hourly ? hourlySuffix : dailySuffix));
+
+	// Hidden, so an interrupted run can't be mistaken for an archive at startup
+	const std::filesystem::path outputPath(outputFileName);
+	const std::string tempFileName((outputPath.parent_path() / ('.' + outputPath.filename().string() + ".tmp")).string());
+
+	const ArchiveCatalog::EpochSeconds bucketSize(target == Tier::Hourly ? 3600 : 86400);
+	std::error_code ec;
+	if (!Aggregate(inputFileName, tempFileName, bucketSize))
+	{
+		std::filesystem::remove(tempFileName, ec);
+		return false;
+	}
+
+	std::filesystem::rename(tempFileName, outputFileName, ec);
+	if (ec)
+	{
+		log << "ERROR:  Failed to rename '" << tempFileName << "':  " << ec.message() << std::endl;
+		std::filesystem::remove(tempFileName, ec);
+		return false;
+	}
+
+	if (!catalog.ReplaceArchive(candidate.series, inputFileName, outputFileName))
+	{
+		std::filesystem::remove(outputFileName, ec);
+		return false;
+	}
+
+	const auto inputSize(std::filesystem::file_size(inputFileName, ec));
+	std::filesystem::remove(inputFileName, ec);
+	if (ec)
+		log << "Warning:  Failed to remove '" << inputFileName << "':  " << ec.message() << std::endl;
+
+	log << "Reduced '" << inputFileName << "' (" << inputSize / 1024 << " kB) to " << (target == Tier::Hourly ? "hourly" : "daily")
+		<< " averages in '" << outputFileName << "' (" << std::filesystem::file_size(outputFileName, ec) / 1024 << " kB)" << std::endl;
+	return true;
+}
+
+bool HistoryCompactor::Aggregate(const std::string& inputFileName, const std::string& outputFileName, const ArchiveCatalog::EpochSeconds& bucketSize) const
+{
+	std::ifstream inFile(inputFileName);
+	if (!inFile.is_open())
+	{
+		log << "Warning:  Failed to open '" << inputFileName << "' for compaction" << std::endl;
+		return false;
+	}
+
+	std::ofstream outFile(outputFileName);
+	if (!outFile.is_open())
+	{
+		log << "Failed to open '" << outputFileName << "' for output" << std::endl;
+		return false;
+	}
+
+	std::string line;
+	if (std::getline(inFile, line))
+		outFile << line << '\n';// Header row
+
+	ArchiveCatalog::EpochSeconds bucket(0);
+	std::vector<double> sums;
+	unsigned int count(0);
+	const auto writeBucket([&]()
+	{
+		if (count == 0)
+			return;
+
+		outFile << formatTime(bucket);
+		for (const auto& sum : sums)
+			outFile << ',' << sum / count;
+		outFile << '\n';
+	});
+
+	std::vector<double> values;
+	while (std::getline(inFile, line))
+	{
+		std::istringstream ss(line);
+		std::string token;
+		ArchiveCatalog::EpochSeconds t;
+		if (!std::getline(ss, token, ',') || !parseTime(token, t))
+			continue;
+
+		values.clear();
+		bool lineOK(true);
+		while (lineOK && std::getline(ss, token, ','))
+		{
+			std::istringstream valueSS(token);
+			double value;
+			lineOK = !(valueSS >> value).fail();
+			values.push_back(value);
+		}
+
+		if (!lineOK || (count > 0 && values.size() != sums.size()))
+			continue;
+
+		const ArchiveCatalog::EpochSeconds lineBucket(t - ((t % bucketSize) + bucketSize) % bucketSize);
+		if (count == 0 || lineBucket != bucket)
+		{
+			writeBucket();
+			bucket = lineBucket;
+			sums.assign(values.size(), 0.0);
+			count = 0;
+		}
+
+		for (size_t i = 0; i < values.size(); ++i)
+			sums[i] += values[i];
+		++count;
+	}
+
+	writeBucket();
+
+	outFile.close();
+	if (outFile.fail())
+	{
+		log << "ERROR:  Failed to write '" << outputFileName << "'" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+HistoryCompactor::Tier HistoryCompactor::GetTier(const std::string& fileName)
+{
+	const auto endsWith([&fileName](const std::string& suffix)
+	{
+		return fileName.size() >= suffix.size() && fileName.compare(fileName.size() - suffix.size(), suffix.size(), suffix) == 0;
+	});
+
+	if (endsWith(hourlySuffix))
+		return Tier::Hourly;
+	else if (endsWith(dailySuffix))
+		return Tier::Daily;
+	return Tier::Raw;
+}
+
+std::string HistoryCompactor::GetBaseName(const std::string& fileName)
+{
+	switch (GetTier(fileName))
+	{
+	case Tier::Hourly:
+		return fileName.substr(0, fileName.size() - hourlySuffix.size());
+
+	case Tier::Daily:
+		return fileName.substr(0, fileName.size() - dailySuffix.size());
+
+	default:
+		break;
+	}
+
+	return fileName;
+}
+
+void HistoryCompactor::SetIdlePriority(UString::OStream& log)
+{
+	// From linux/ioprio.h, which glibc doesn't expose; both calls below affect only this thread
+	const int ioprioWhoProcess(1);
+	const int ioprioClassIdle(3);
+	const int ioprioClassShift(13);
+	if (syscall(SYS_ioprio_set, ioprioWhoProcess, 0, ioprioClassIdle << ioprioClassShift) != 0)
+		log << "Warning:  Failed to set idle I/O priority for history compaction" << std::endl;
+
+	const int lowestPriority(19);
+	if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), lowestPriority) != 0)
+		log << "Warning:  Failed to lower CPU priority for history compaction" << std::endl;
+}
@@ -0,0 +1,102 @@
+// File:  historyCompactor.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Background downsampling and removal of old log archives to bound disk usage.
+
+#ifndef HISTORY_COMPACTOR_H_
+#define HISTORY_COMPACTOR_H_
+
+// Local headers
+#include "archiveCatalog.h"
+#include "liveConfig.h"
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Archives pass through three tiers:  the raw rotated log (<log>_<time>), hourly averages
+// (<log>_<time>.hourly) and daily averages (<log>_<time>.daily).  Aggregated archives keep the
+// CSV layout of the log they came from, so the catalog, queries and export treat every tier
+// alike.  Each archive moves to the next tier once its newest row is older than the configured
+// age.  If the history exceeds the disk budget, the oldest archives are moved along early and,
+// as a last resort, the oldest daily archives are deleted.  One archive is processed at a time
+// at idle I/O priority.  Archives still waiting to be compressed and emailed are left alone.
+//
+// The budget covers every file whose name starts with one of the unmanaged prefixes (the active
+// logs, the application log and its rotated copies, ping captures) as well as the archives and
+// their compressed copies.  Only archives are ever reduced or deleted, so if the other files alone
+// exceed the budget, a warning is logged instead of deleting archives that couldn't help.
+class HistoryCompactor
+{
+public:
+	typedef std::function<std::string(const ArchiveCatalog::EpochSeconds& t)> TimeFormatter;
+	typedef std::function<bool(const std::string& archiveFileName)> PendingCheck;
+
+	// Files matching unmanagedFilePrefixes are counted against the budget but never modified
+	HistoryCompactor(const LiveConfig& liveConfig, ArchiveCatalog& catalog, const std::vector<std::string>& unmanagedFilePrefixes,
+		const PendingCheck& isRotationPending, const ArchiveCatalog::TimeParser& parseTime, const TimeFormatter& formatTime, UString::OStream& log);
+
+	void Run();
+	void Stop();
+
+private:
+	static const std::chrono::minutes startupDelay;
+	static const std::chrono::hours checkPeriod;
+	static const std::chrono::seconds stepDelay;
+	static const std::string hourlySuffix;
+	static const std::string dailySuffix;
+
+	const LiveConfig& liveConfig;
+	ArchiveCatalog& catalog;
+	const std::vector<std::string> unmanagedFilePrefixes;
+	const PendingCheck isRotationPending;
+	const ArchiveCatalog::TimeParser parseTime;
+	const TimeFormatter formatTime;
+	UString::OStream& log;
+
+	std::mutex stopMutex;
+	std::condition_variable stopCondition;
+	std::atomic<bool> stopRequested = false;
+
+	enum class Tier
+	{
+		Raw,
+		Hourly,
+		Daily
+	};
+
+	struct Candidate
+	{
+		ArchiveCatalog::Series series;
+		ArchiveCatalog::Summary archive;
+		Tier tier;
+	};
+
+	void Compact();
+	void EnforceBudget(const std::uintmax_t& budget);// [bytes]
+	bool RemoveStaleCompressedCopy(const std::vector<Candidate>& candidates);
+
+	// Sorted by the time of the newest row; excludes archives with a pending rotation
+	std::vector<Candidate> GetCandidates() const;
+	std::uintmax_t GetHistorySize() const;// [bytes]
+	static std::uintmax_t GetArchiveSize(const Candidate& candidate);// [bytes], including any compressed copy
+
+	bool Downsample(const Candidate& candidate, const Tier& target);
+	bool Aggregate(const std::string& inputFileName, const std::string& outputFileName, const ArchiveCatalog::EpochSeconds& bucketSize) const;
+
+	// Returns false if a stop was requested during the wait
+	bool Pause(const std::chrono::steady_clock::duration& duration);
+
+	static Tier GetTier(const std::string& fileName);
+	static std::string GetBaseName(const std::string& fileName);
+	static void SetIdlePriority(UString::OStream& log);
+};
+
+#endif// HISTORY_COMPACTOR_H_
@@ -0,0 +1,108 @@
+// File:  historyIndex.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  In-memory, time-ordered oil and temperature history for fast queries.
+
+// Local headers
+#include "historyIndex.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <mutex>
+
+void HistoryIndex::AddOil(const OilSample& sample)
+{
+	std::unique_lock<std::shared_mutex> lock(mutex);
+	InsertOrdered(oil, sample);
+}
+
+void HistoryIndex::AddTemperature(const TemperatureSample& sample)
+{
+	std::unique_lock<std::shared_mutex> lock(mutex);
+	InsertOrdered(temperature, sample);
+}
+
+void HistoryIndex::SetDaysToEmpty(const double& days)
+{
+	std::unique_lock<std::shared_mutex> lock(mutex);
+	daysToEmpty = days;
+}
+
+bool HistoryIndex::GetLatestOil(OilSample& sample) const
+{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	if (oil.empty())
+		return false;
+	sample = oil.back();
+	return true;
+}
+
+bool HistoryIndex::GetLatestTemperature(TemperatureSample& sample) const
+{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	if (temperature.empty())
+		return false;
+	sample = temperature.back();
+	return true;
+}
+
+bool HistoryIndex::GetEarliestOil(OilSample& sample) const
+{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	if (oil.empty())
+		return false;
+	sample = oil.front();
+	return true;
+}
+
+bool HistoryIndex::GetEarliestTemperature(TemperatureSample& sample) const
+{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	if (temperature.empty())
+		return false;
+	sample = temperature.front();
+	return true;
+}
+
+double HistoryIndex::GetDaysToEmpty() const
+{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	return daysToEmpty;
+}
+
+void HistoryIndex::GetOil(const EpochSeconds& from, const EpochSeconds& to, std::vector<OilSample>& out) const
+{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	CopyRange(oil, from, to, out);
+}
+
+void HistoryIndex::GetTemperature(const EpochSeconds& from, const EpochSeconds& to, std::vector<TemperatureSample>& out) const
+{
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	CopyRange(temperature, from, to, out);
+}
+
+template<typename T>
+void HistoryIndex::InsertOrdered(std::vector<T>& series, const T& sample)
+{
+	// Samples almost always arrive in order, but tolerate the clock stepping backward
+	if (series.empty() || series.back().t <= sample.t)
+		series.push_back(sample);
+	else
+		series.insert(std::upper_bound(series.begin(), series.end(), sample.t,
+			[](const EpochSeconds& t, const T& s) { return t < s.t; }), sample);
+}
+
+template<typename T>
+void HistoryIndex::CopyRange(const std::vector<T>& series, const EpochSeconds& from, const EpochSeconds& to, std::vector<T>& out)
+{
+	out.clear();
+	if (to < from)
+		return;
+
+	const auto first(std::lower_bound(series.begin(), series.end(), from,
+		[](const T& s, const EpochSeconds& t) { return s.t < t; }));
+	const auto last(std::upper_bound(first, series.end(), to,
+		[](const EpochSeconds& t, const T& s) { return t < s.t; }));
+	out.assign(first, last);
+}
@@ -0,0 +1,61 @@
+// File:  historyIndex.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  In-memory, time-ordered oil and temperature history for fast queries.
+
+#ifndef HISTORY_INDEX_H_
+#define HISTORY_INDEX_H_
+
+// Standard C++ headers
+#include <vector>
+#include <shared_mutex>
+#include <cstdint>
+#include <limits>
+
+class HistoryIndex
+{
+public:
+	typedef std::int64_t EpochSeconds;// UTC
+
+	struct OilSample
+	{
+		EpochSeconds t;
+		double distance;// [in]
+		double volume;// [gal]
+	};
+
+	struct TemperatureSample
+	{
+		EpochSeconds t;
+		double temperature;// [deg F]
+	};
+
+	void AddOil(const OilSample& sample);
+	void AddTemperature(const TemperatureSample& sample);
+	void SetDaysToEmpty(const double& days);
+
+	bool GetLatestOil(OilSample& sample) const;
+	bool GetLatestTemperature(TemperatureSample& sample) const;
+	double GetDaysToEmpty() const;// NaN if not yet estimated
+
+	bool GetEarliestOil(OilSample& sample) const;
+	bool GetEarliestTemperature(TemperatureSample& sample) const;
+
+	// Copies samples with from <= t <= to into out (cleared first)
+	void GetOil(const EpochSeconds& from, const EpochSeconds& to, std::vector<OilSample>& out) const;
+	void GetTemperature(const EpochSeconds& from, const EpochSeconds& to, std::vector<TemperatureSample>& out) const;
+
+private:
+	mutable std::shared_mutex mutex;
+
+	std::vector<OilSample> oil;
+	std::vector<TemperatureSample> temperature;
+	double daysToEmpty = std::numeric_limits<double>::quiet_NaN();
+
+	template<typename T>
+	static void InsertOrdered(std::vector<T>& series, const T& sample);
+	template<typename T>
+	static void CopyRange(const std::vector<T>& series, const EpochSeconds& from, const EpochSeconds& to, std::vector<T>& out);
+};
+
+#endif// HISTORY_INDEX_H_
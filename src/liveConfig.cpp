@@ -0,0 +1,77 @@
+// File:  liveConfig.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Lock-free access to a configuration that may be replaced while running.
+
+// Local headers
+#include "liveConfig.h"
+
+LiveConfig::LiveConfig(const OilCheckerConfig& initial)
+{
+	snapshots.push_back(std::make_unique<const OilCheckerConfig>(initial));
+	current.store(snapshots.back().get(), std::memory_order_release);
+}
+
+void LiveConfig::Publish(const OilCheckerConfig& newConfig)
+{
+	std::lock_guard<std::mutex> lock(publishMutex);
+	snapshots.push_back(std::make_unique<const OilCheckerConfig>(newConfig));
+	current.store(snapshots.back().get(), std::memory_order_release);
+}
+
+OilCheckerConfig LiveConfig::MergeLiveChanges(const OilCheckerConfig& current, const OilCheckerConfig& edited, UString::OStream& log)
+{
+	OilCheckerConfig merged(current);
+	merged.lowLevelThreshold = edited.lowLevelThreshold;
+	merged.daysToEmptyWarning = edited.daysToEmptyWarning;
+	merged.measurementCountForEstimatingEmptyDate = edited.measurementCountForEstimatingEmptyDate;
+	merged.alerts = edited.alerts;
+	merged.anomaly = edited.anomaly;
+
+	merged.temperatureMeasurementPeriod = edited.temperatureMeasurementPeriod;
+	merged.oilMeasurementPeriod = edited.oilMeasurementPeriod;
+	merged.minOilPeriod = edited.minOilPeriod;
+	merged.maxOilPeriod = edited.maxOilPeriod;
+	merged.summaryEmailPeriod = edited.summaryEmailPeriod;
+	merged.logFileRestartPeriod = edited.logFileRestartPeriod;
+
+	merged.email.recipients = edited.email.recipients;
+
+	merged.ping.minTimeBetweenPings = edited.ping.minTimeBetweenPings;
+	merged.ping.measurementsToAverage = edited.ping.measurementsToAverage;
+
+	merged.sendDebugEmail = edited.sendDebugEmail;
+	merged.logging.level = edited.logging.level;
+	merged.retention = edited.retention;
+
+	if (edited.tankDimensions.height != current.tankDimensions.height ||
+		edited.tankDimensions.width != current.tankDimensions.width ||
+		edited.tankDimensions.length != current.tankDimensions.length ||
+		edited.tankDimensions.heightOffset != current.tankDimensions.heightOffset)
+		log << "Warning:  Tank dimension changes require a restart to take effect" << std::endl;
+
+	if (edited.ping.triggerPin != current.ping.triggerPin ||
+		edited.ping.echoPin != current.ping.echoPin ||
+		edited.ping.useEdgeEvents != current.ping.useEdgeEvents ||
+		edited.ping.gpioChip != current.ping.gpioChip ||
+		edited.ping.triggerLine != current.ping.triggerLine ||
+		edited.ping.echoLine != current.ping.echoLine ||
+		edited.ping.simulatedDistance != current.ping.simulatedDistance)
+		log << "Warning:  Ping sensor wiring changes require a restart to take effect" << std::endl;
+
+	if (edited.ping.captureSize != current.ping.captureSize)
+		log << "Warning:  Ping capture size changes require a restart to take effect" << std::endl;
+
+	if (edited.email.sender != current.email.sender ||
+		edited.email.oAuth2ClientID != current.email.oAuth2ClientID ||
+		edited.email.oAuth2ClientSecret != current.email.oAuth2ClientSecret ||
+		edited.email.caCertificatePath != current.email.caCertificatePath ||
+		edited.email.oAuth2TokenURL != current.email.oAuth2TokenURL)
+		log << "Warning:  Email account changes require a restart to take effect" << std::endl;
+
+	if (edited.logging.maxFileSize != current.logging.maxFileSize ||
+		edited.logging.filesToKeep != current.logging.filesToKeep)
+		log << "Warning:  Log rotation changes require a restart to take effect" << std::endl;
+
+	return merged;
+}
@@ -0,0 +1,40 @@
+// File:  liveConfig.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Lock-free access to a configuration that may be replaced while running.
+
+#ifndef LIVE_CONFIG_H_
+#define LIVE_CONFIG_H_
+
+// Local headers
+#include "oilCheckerConfig.h"
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// RCU-style holder:  readers grab the current immutable snapshot with a single atomic load,
+// writers publish a complete replacement.  Old snapshots are retained until destruction
+// (edits are rare and small) so a reader's reference can never dangle.
+class LiveConfig
+{
+public:
+	explicit LiveConfig(const OilCheckerConfig& initial);
+
+	const OilCheckerConfig& Get() const { return *current.load(std::memory_order_acquire); }
+	void Publish(const OilCheckerConfig& newConfig);
+
+	// Copies the subset of edited values that can be applied without restarting and
+	// reports any other differences
+	static OilCheckerConfig MergeLiveChanges(const OilCheckerConfig& current, const OilCheckerConfig& edited, UString::OStream& log);
+
+private:
+	std::mutex publishMutex;
+	std::vector<std::unique_ptr<const OilCheckerConfig>> snapshots;
+	std::atomic<const OilCheckerConfig*> current;
+};
+
+#endif// LIVE_CONFIG_H_
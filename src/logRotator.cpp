@@ -0,0 +1,97 @@
+// File:  logRotator.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Compresses and emails rotated log files on a background thread.
+
+// Local headers
+#include "logRotator.h"
+#include "gzipUtilities.h"
+
+// Standard C++ headers
+#include <filesystem>
+#include <algorithm>
+
+const unsigned int LogRotator::maxSendAttempts(5);
+const std::chrono::minutes LogRotator::retryDelay(30);
+
+void LogRotator::Enqueue(const std::string& archiveFileName)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(archiveFileName);
+	}
+
+	condition.notify_all();
+}
+
+bool LogRotator::IsPending(const std::string& archiveFileName) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return archiveFileName == processing || std::find(pending.begin(), pending.end(), archiveFileName) != pending.end();
+}
+
+void LogRotator::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopRequested = true;
+	}
+
+	condition.notify_all();
+}
+
+void LogRotator::Run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		condition.wait(lock, [this]() { return stopRequested || !pending.empty(); });
+		if (stopRequested)
+			break;
+
+		processing = pending.front();
+		pending.pop_front();
+
+		const std::string archiveFileName(processing);
+		lock.unlock();
+		Process(archiveFileName);
+		lock.lock();
+		processing.clear();
+	}
+
+	if (!pending.empty())
+		log << "Warning:  " << pending.size() << " rotated log file(s) were not emailed before shutdown" << std::endl;
+}
+
+void LogRotator::Process(const std::string& archiveFileName)
+{
+	catalog(archiveFileName);
+
+	const std::string compressedFileName(archiveFileName + ".gz");
+	log << "Compressing '" << archiveFileName << "'" << std::endl;
+	if (!GZipUtilities::CompressFile(archiveFileName, compressedFileName))
+	{
+		log << "Warning:  Failed to compress '" << archiveFileName << "'; sending uncompressed" << std::endl;
+		std::error_code ec;
+		std::filesystem::remove(compressedFileName, ec);
+		send(archiveFileName, archiveFileName);
+		return;
+	}
+
+	for (unsigned int attempt = 1; attempt <= maxSendAttempts; ++attempt)
+	{
+		if (send(archiveFileName, compressedFileName))
+		{
+			// The uncompressed archive stays behind as the local copy
+			std::error_code ec;
+			std::filesystem::remove(compressedFileName, ec);
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		if (condition.wait_for(lock, retryDelay, [this]() { return stopRequested; }))
+			break;
+	}
+
+	log << "Warning:  Gave up emailing '" << compressedFileName << "'; the file has been kept" << std::endl;
+}
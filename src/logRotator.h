@@ -0,0 +1,54 @@
+// File:  logRotator.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Compresses and emails rotated log files on a background thread.
+
+#ifndef LOG_ROTATOR_H_
+#define LOG_ROTATOR_H_
+
+// Local headers
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+
+class LogRotator
+{
+public:
+	typedef std::function<bool(const std::string& archiveFileName, const std::string& attachmentFileName)> SendFunction;
+	typedef std::function<void(const std::string& archiveFileName)> CatalogFunction;
+
+	LogRotator(const SendFunction& send, const CatalogFunction& catalog, UString::OStream& log) : send(send), catalog(catalog), log(log) {}
+
+	// Queues an already-renamed log file; returns immediately
+	void Enqueue(const std::string& archiveFileName);
+
+	// True until the file has been compressed and emailed (or given up on)
+	bool IsPending(const std::string& archiveFileName) const;
+
+	void Run();
+	void Stop();
+
+private:
+	static const unsigned int maxSendAttempts;
+	static const std::chrono::minutes retryDelay;
+
+	const SendFunction send;
+	const CatalogFunction catalog;
+	UString::OStream& log;
+
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<std::string> pending;
+	std::string processing;
+	bool stopRequested = false;
+
+	void Process(const std::string& archiveFileName);
+};
+
+#endif// LOG_ROTATOR_H_
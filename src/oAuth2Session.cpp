@@ -0,0 +1,115 @@
+// File:  oAuth2Session.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Deferred OAuth2 setup, so no network access is needed until the first email.
+
+// Local headers
+#include "oAuth2Session.h"
+#include "email/oAuth2Interface.h"
+
+// Standard C++ headers
+#include <fstream>
+
+const std::string OAuth2Session::tokenFileName(".oilCheckerOAuth");
+
+OAuth2Session::OAuth2Session(const EmailConfig& config, UString::OStream& log) : config(config), log(log)
+{
+}
+
+bool OAuth2Session::NeedsInteractiveSetup() const
+{
+	std::ifstream tokenFile(tokenFileName);
+	std::string token;
+	return !tokenFile.is_open() || !std::getline(tokenFile, token) || token.empty();
+}
+
+bool OAuth2Session::Initialize()
+{
+	std::lock_guard<std::mutex> initializeLock(initializeMutex);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (initialized)
+			return true;
+	}
+
+	std::string token;
+	if (!InitializeInterface(token))
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	refreshToken = token;
+	initialized = true;
+	return true;
+}
+
+std::string OAuth2Session::GetRefreshToken() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return refreshToken;
+}
+
+bool OAuth2Session::InitializeInterface(std::string& token)
+{
+	log << "Setting up OAuth2" << std::endl;
+
+	OAuth2Interface::Get().SetLoggingTarget(log);
+
+	OAuth2Interface::Get().SetClientID(config.oAuth2ClientID);
+	OAuth2Interface::Get().SetClientSecret(config.oAuth2ClientSecret);
+	OAuth2Interface::Get().SetVerboseOutput(false);
+	if (!config.caCertificatePath.empty())
+		OAuth2Interface::Get().SetCACertificatePath(config.caCertificatePath);
+
+	// Originally, this was for windows only, but device access does not
+	// support full access to e-mail.  So the user has some typing to do...
+#if 1//#ifdef _WIN32
+	OAuth2Interface::Get().SetTokenURL(UString::ToStringType(config.oAuth2TokenURL));
+	OAuth2Interface::Get().SetAuthenticationURL(_T("https://accounts.google.com/o/oauth2/auth"));
+	OAuth2Interface::Get().SetResponseType(_T("code"));
+	OAuth2Interface::Get().SetRedirectURI(_T("urn:ietf:wg:oauth:2.0:oob"));
+	OAuth2Interface::Get().SetLoginHint(config.sender);
+	OAuth2Interface::Get().SetGrantType(_T("authorization_code"));
+	//OAuth2Interface::Get().SetScope(_T("https://www.googleapis.com/auth/gmail.send"));
+	OAuth2Interface::Get().SetScope(_T("https://mail.google.com/"));
+#else
+	OAuth2Interface::Get().SetTokenURL(_T("https://www.googleapis.com/oauth2/v3/token"));
+	OAuth2Interface::Get().SetAuthenticationURL(_T("https://accounts.google.com/o/oauth2/device/code"));
+	OAuth2Interface::Get().SetAuthenticationPollURL(_T("https://oauth2.googleapis.com/token"));
+	OAuth2Interface::Get().SetGrantType(_T("http://oauth.net/grant_type/device/1.0"));
+	OAuth2Interface::Get().SetPollGrantType(_T("urn:ietf:params:oauth:grant-type:device_code"));
+	OAuth2Interface::Get().SetScope(_T("email"));
+#endif
+
+	// Set the refresh token (one will be created, if this is the first login)
+	std::string oAuth2Token;
+	{
+		std::ifstream tokenFile(tokenFileName);
+		if (tokenFile.is_open())// If it's not found, no error since that just means we haven't logged in yet
+			std::getline(tokenFile, oAuth2Token);
+		else
+			log << "Could not open '" << tokenFileName << "' for input; will request new token..." << std::endl;
+	}
+
+	OAuth2Interface::Get().SetRefreshToken(oAuth2Token);
+	if (OAuth2Interface::Get().GetRefreshToken() != oAuth2Token)
+	{
+		oAuth2Token = OAuth2Interface::Get().GetRefreshToken();
+		std::ofstream tokenFile(tokenFileName);
+		if (tokenFile.is_open())
+		{
+			tokenFile << oAuth2Token;
+			log << "Updated OAuth2 refresh token written to " << tokenFileName << std::endl;
+		}
+		else
+			log << "Failed to write updated OAuth2 refresh token to " << tokenFileName << std::endl;
+	}
+
+	if (OAuth2Interface::Get().GetRefreshToken().empty())
+	{
+		log << "Failed to obtain refresh token" << std::endl;
+		return false;
+	}
+
+	token = oAuth2Token;
+	return true;
+}
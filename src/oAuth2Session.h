@@ -0,0 +1,51 @@
+// File:  oAuth2Session.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Deferred OAuth2 setup, so no network access is needed until the first email.
+
+#ifndef OAUTH2_SESSION_H_
+#define OAUTH2_SESSION_H_
+
+// Local headers
+#include "oilCheckerConfig.h"
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <mutex>
+
+// EmailSender exchanges the refresh token for an access token itself (through
+// OAuth2Interface), so this class only decides when that interface is configured.
+// It does not cache access tokens or renew them in the background:  EmailSender has
+// no way to accept a pre-fetched access token, so each send still makes its own
+// token request.  That belongs in OAuth2Interface (email library), not here.
+class OAuth2Session
+{
+public:
+	OAuth2Session(const EmailConfig& config, UString::OStream& log);
+
+	// True if no refresh token has been stored yet, in which case the user must complete
+	// the (interactive) authorization before the application can run unattended
+	bool NeedsInteractiveSetup() const;
+
+	// Configures OAuth2Interface and loads (or obtains) the refresh token; later calls do nothing
+	bool Initialize();
+
+	// Empty until Initialize() has succeeded
+	std::string GetRefreshToken() const;
+
+private:
+	static const std::string tokenFileName;
+
+	const EmailConfig config;
+	UString::OStream& log;
+
+	std::mutex initializeMutex;// Serializes setup, which may involve network access
+	mutable std::mutex mutex;// Guards the members below; never held across network access
+	bool initialized = false;
+	std::string refreshToken;
+
+	bool InitializeInterface(std::string& token);
+};
+
+#endif// OAUTH2_SESSION_H_
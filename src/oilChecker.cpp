@@ -8,34 +8,66 @@
 #include "tankGeometry.h"
 #include "rpi/ds18b20Sensor.h"
 #include "rpi/pingSensor.h"
-#include "email/oAuth2Interface.h"
+#include "edgeEventPingSensor.h"
+#include "oilCheckerConfigFile.h"
+#include "asyncLogger.h"
+#include "arrowFileWriter.h"
 
 // Eigen headers
 #include <Eigen/Eigen>
 
 // Standard C++ headers
 #include <filesystem>
-#include <iomanip>
 #include <numeric>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <algorithm>
 
 const std::string OilChecker::oilLogFileName("oilHistory.csv");
 const std::string OilChecker::temperatureLogFileName("temperatureHistory.csv");
 const std::string OilChecker::oilLogCreatedDateFileName(".oilLogCreatedDate");
 const std::string OilChecker::temperatureLogCreatedDateFileName(".temperatureLogCreatedDate");
+const std::string OilChecker::alertStateFileName(".alertState");
+const std::string OilChecker::archiveCatalogFileName(".archiveCatalog");
 
-const unsigned int OilChecker::distanceMeasurementsToAverage(10);
-const unsigned int OilChecker::maxDistanceMeasurementsBeforeError(20);
+const unsigned int OilChecker::maxAttemptsPerAveragedMeasurement(2);
 
 OilChecker::~OilChecker()
 {
 	stopThreads = true;
+	stopCondition.notify_all();
+	configWatcher.Stop();
+	if (configWatchThread.joinable())
+		configWatchThread.join();
+
+	if (queryServer)
+		queryServer->Stop();
+	if (queryServerThread.joinable())
+		queryServerThread.join();
+
+	if (compactor)
+		compactor->Stop();
+	if (compactionThread.joinable())
+		compactionThread.join();
+
 	if (oilMeasurementThread.joinable())
 		oilMeasurementThread.join();
 
 	if (temperatureMeasurementThread.joinable())
 		temperatureMeasurementThread.join();
 
+	// Measurement threads are the only producers, so stop the uploader and rotator after they finish
+	if (telemetry)
+		telemetry->Stop();
+	if (telemetryThread.joinable())
+		telemetryThread.join();
+
+	if (logRotator)
+		logRotator->Stop();
+	if (logRotationThread.joinable())
+		logRotationThread.join();
+
 	if (summaryUpdateThread.joinable())
 		summaryUpdateThread.join();
 }
@@ -44,6 +76,20 @@ void OilChecker::Run()
 {
 	if (!ReadOilLogData(oilDataForRateEstimate))
 		log << "Warning:  Failed to read oil log data" << std::endl;
+	for (const auto& p : oilDataForRateEstimate)
+		history.AddOil(HistoryIndex::OilSample{ToEpochSeconds(p.t), p.v.distance, p.v.volume});
+
+	{
+		std::vector<TemperatureDataPoint> temperatureHistory;
+		if (!ReadTemperatureLogData(temperatureHistory))
+			log << "Warning:  Failed to read temperature log data" << std::endl;
+		for (const auto& p : temperatureHistory)
+			history.AddTemperature(HistoryIndex::TemperatureSample{ToEpochSeconds(p.t), p.v});
+
+		InitializeForecaster(oilDataForRateEstimate, temperatureHistory);
+	}
+
+	InitializeAnomalyDetector(oilDataForRateEstimate);
 	
 	if (!std::filesystem::exists(oilLogCreatedDateFileName))
 		WriteLogCreatedDate(oilLogCreatedDateFileName, log);
@@ -53,28 +99,104 @@ void OilChecker::Run()
 	oilLogCreatedDate = ReadLogCreatedDate(oilLogCreatedDateFileName, log);
 	temperatureLogCreatedDate = ReadLogCreatedDate(temperatureLogCreatedDateFileName, log);
 	
+	// The seqlock allows only one writer, so publish the startup values before the measurement threads can
+	const std::string& sharedMemoryName(liveConfig.Get().sharedMemoryName);
+	if (!sharedMemoryName.empty())
+	{
+		sharedReadings = std::make_unique<SharedReadingsWriter>(sharedMemoryName, log);
+		HistoryIndex::OilSample latestOil;
+		if (history.GetLatestOil(latestOil))
+			sharedReadings->PublishOil(latestOil.t, latestOil.distance, latestOil.volume, history.GetDaysToEmpty());
+		HistoryIndex::TemperatureSample latestTemperature;
+		if (history.GetLatestTemperature(latestTemperature))
+			sharedReadings->PublishTemperature(latestTemperature.t, latestTemperature.temperature);
+	}
+
+	archiveCatalog.Reconcile(ArchiveCatalog::Series::Oil, GetArchiveFiles(oilLogFileName));
+	archiveCatalog.Reconcile(ArchiveCatalog::Series::Temperature, GetArchiveFiles(temperatureLogFileName));
+
+	logRotator = std::make_unique<LogRotator>([this](const std::string& archiveFileName, const std::string& attachmentFileName)
+	{
+		return SendNewLogFileEmail(archiveFileName, attachmentFileName);
+	}, [this](const std::string& archiveFileName)
+	{
+		const bool isOil(archiveFileName.compare(0, oilLogFileName.size(), oilLogFileName) == 0);
+		archiveCatalog.AddArchive(isOil ? ArchiveCatalog::Series::Oil : ArchiveCatalog::Series::Temperature, archiveFileName);
+	}, log);
+	logRotationThread = std::thread(&LogRotator::Run, logRotator.get());
+
+	const TelemetryConfig& telemetryConfig(liveConfig.Get().telemetry);
+	if (!telemetryConfig.url.empty())
+	{
+		telemetry = std::make_unique<TelemetryUploader>(telemetryConfig, liveConfig.Get().email.caCertificatePath, log);
+		telemetryThread = std::thread(&TelemetryUploader::Run, telemetry.get());
+	}
+
+	// Everything the measurement threads use must exist before they start
 	oilMeasurementThread = std::thread(&OilChecker::OilMeasurementThreadEntry, this);
 	temperatureMeasurementThread = std::thread(&OilChecker::TemperatureMeasurementThreadEntry, this);
 	summaryUpdateThread = std::thread(&OilChecker::SummaryUpdateThreadEntry, this);
 
+	// Prefixes cover the active logs along with anything else we leave in the working directory
+	std::vector<std::string> unmanagedFilePrefixes{ oilLogFileName, temperatureLogFileName, PingCapture::fileNamePrefix };
+	if (auto asyncLog = dynamic_cast<AsyncLogger*>(&log))
+		unmanagedFilePrefixes.push_back(asyncLog->GetFileName());// Also matches the rotated copies
+
+	compactor = std::make_unique<HistoryCompactor>(liveConfig, archiveCatalog, unmanagedFilePrefixes, [this](const std::string& archiveFileName)
+	{
+		return logRotator->IsPending(archiveFileName);
+	}, &OilChecker::ParseEpochSeconds, &OilChecker::FormatEpochSeconds, log);
+	compactionThread = std::thread(&HistoryCompactor::Run, compactor.get());
+
+	const std::string& querySocketPath(liveConfig.Get().querySocketPath);
+	if (!querySocketPath.empty())
+	{
+		queryServer = std::make_unique<QueryServer>(querySocketPath, history, archiveCatalog, pingCapture, log);
+		if (queryServer->IsOK())
+			queryServerThread = std::thread(&QueryServer::Run, queryServer.get());
+		else
+			log << "Warning:  Query interface is unavailable" << std::endl;
+	}
+
+	if (configWatcher.IsOK())
+		configWatchThread = std::thread(&OilChecker::ConfigWatchThreadEntry, this);
+	else
+		log << "Warning:  Changes to '" << configFileName << "' will not be applied until restart" << std::endl;
+
 	std::unique_lock<std::mutex> lock(stopMutex);
 	stopCondition.wait(lock, [this] { return stopThreads.load(); });
 }
 
 void OilChecker::OilMeasurementThreadEntry()
 {
+	// Ping captures are snapshotted under activityMutex but written after releasing it, so a slow
+	// SD card doesn't hold up the other threads
+	PingCapture::Snapshot capture;
+	std::string captureReason;
+	const auto writeCapture([this, &capture, &captureReason]()
+	{
+		std::string fileName;
+		if (!captureReason.empty())
+			pingCapture.Write(capture, captureReason, fileName);
+		captureReason.clear();
+	});
+
 	while (!stopThreads)
 	{
-		const std::chrono::steady_clock::duration period(std::chrono::minutes(config.oilMeasurementPeriod));
-		const auto wakeTime(std::chrono::steady_clock::now() + period);
+		const auto startTime(std::chrono::steady_clock::now());
+		AlertManager::Digest alertDigest;
 
 		{
 			std::unique_lock<std::mutex> lock(activityMutex);
+			const OilCheckerConfig& config(liveConfig.Get());
 
 			VolumeDistance values;
-			if (!GetRemainingOilVolume(values))
+			AnomalyDetector::SensorQuality sensorQuality;
+			if (!GetRemainingOilVolume(values, sensorQuality))
 			{
 				log << "ERROR:  Failed to get remaining oil volume" << std::endl;
+				if (pingCapture.TakeSnapshot(capture))
+					captureReason = "measurement failed";
 				stopThreads = true;
 				stopCondition.notify_all();
 				break;
@@ -83,53 +205,130 @@ void OilChecker::OilMeasurementThreadEntry()
 			if (!WriteOilLogData(values))
 				log << "Warning:  Failed to log oil data (v = " << values.volume << " gal, d = " << values.distance << " in)" << std::endl;
 				
-			RemoveDataBeforeRefill(oilDataForRateEstimate);
-			const double daysToEmpty(EstimateDaysToEmpty());
-			log << "Estimated days to empty:  " << daysToEmpty << std::endl;
+			// Check against the forecaster's expected rate before this sample is folded into it
+			const double expectedRate(forecaster.IsReady() ? forecaster.GetForecast(values.volume).consumptionRate : std::numeric_limits<double>::quiet_NaN());
+			const AnomalyDetector::VolumeResult anomaly(anomalyDetector.AddVolume(config.anomaly, std::chrono::system_clock::now(), values.volume, expectedRate));
+			if (anomaly.refill)
+				oilDataForRateEstimate.clear();
+
+			forecaster.AddVolume(std::chrono::system_clock::now(), values.volume, config.anomaly.refillVolume);
+			LimitRateEstimateData(oilDataForRateEstimate);
+			const ConsumptionForecaster::Forecast forecast(ForecastDaysToEmpty(values.volume));
+			const double daysToEmpty(forecast.daysToEmpty);
+			log << "Estimated days to empty:  ";
+			WriteDaysToEmpty(log, daysToEmpty);
+			if (!std::isnan(forecast.lowerBound))
+			{
+				log << " (95% interval ";
+				WriteDaysToEmpty(log, forecast.lowerBound);
+				log << " to ";
+				WriteDaysToEmpty(log, forecast.upperBound);
+				log << "; consuming " << forecast.consumptionRate << " gal/day)";
+			}
+			log << std::endl;
+			history.SetDaysToEmpty(daysToEmpty);
 			
+			std::string debugText;
 			if (config.sendDebugEmail)
 			{
 				std::ostringstream ss;
-				ss << "Measured distance = " << values.distance << " in\nCalculated volume remaining = " << values.volume << " gal\nEstimated days to empty = " << daysToEmpty << " days";
-				if (!SendDebugEmail("Oil Level Checker Debug Message", ss.str()))
-					log << "Failed to send debug email" << std::endl;
+				ss << "Measured distance = " << values.distance << " in\nCalculated volume remaining = " << values.volume << " gal\nEstimated days to empty = ";
+				WriteDaysToEmpty(ss, daysToEmpty);
+				debugText = ss.str();
 			}
 
 			if (values.volume < config.lowLevelThreshold || daysToEmpty < config.daysToEmptyWarning)
-			{
 				log << "Low oil level detected!" << std::endl;
-				if (!SendLowOilLevelEmail(values.volume, daysToEmpty))
-					log << "Warning:  Failed to send low oil warning email" << std::endl;
+
+			UString::OStringStream detail;
+			detail.precision(1);
+			detail << std::fixed << "Only " << values.volume << " gal of oil remains in the tank (warning threshold is " << config.lowLevelThreshold << " gal).";
+			const auto now(std::chrono::system_clock::now());
+			alertManager.EvaluateBelow(AlertManager::AlertType::LowLevel, values.volume, config.lowLevelThreshold, config.alerts.lowLevelHysteresis, detail.str(), now);
+
+			detail.str(std::string());
+			if (!std::isfinite(daysToEmpty))
+				detail << "No oil consumption is expected at current temperatures, so the tank is not projected to run out.";
+			else
+			{
+				detail << "The tank is projected to be empty in " << daysToEmpty << " days";
+				if (!std::isnan(forecast.lowerBound) && std::isfinite(forecast.upperBound))
+					detail << " (likely between " << forecast.lowerBound << " and " << forecast.upperBound << " days at current temperatures)";
+				else if (!std::isnan(forecast.lowerBound))
+					detail << " (likely at least " << forecast.lowerBound << " days at current temperatures)";
+				detail << '.';
+			}
+			alertManager.EvaluateBelow(AlertManager::AlertType::DaysToEmpty, daysToEmpty, config.daysToEmptyWarning, config.alerts.daysToEmptyHysteresis, detail.str(), now);
+
+			if (anomaly.refill)
+			{
+				detail.str(std::string());
+				detail << "The oil level rose by " << anomaly.volumeChange << " gal to " << values.volume << " gal.";
+				alertManager.RaiseEvent(AlertManager::AlertType::Refill, detail.str(), now);
+			}
+
+			if (anomaly.abnormalDrop)
+			{
+				log << "Warning:  Abnormal loss of oil detected" << std::endl;
+				detail.str(std::string());
+				detail << "About " << anomaly.volumeChange << " gal more oil than expected was used over the last " << anomaly.days * 24.0 << " hours.  Check the tank and lines for a leak or theft.";
+				alertManager.RaiseEvent(AlertManager::AlertType::AbnormalDrop, detail.str(), now);
 			}
 
+			std::string sensorDetail;
+			const bool sensorFault(anomalyDetector.AddSensorQuality(config.anomaly, sensorQuality, sensorDetail));
+			alertManager.EvaluateCondition(AlertManager::AlertType::SensorFault, sensorFault, sensorDetail, now);
+
+			if ((anomaly.abnormalDrop || (sensorFault && !sensorFaultActive)) && pingCapture.TakeSnapshot(capture))
+				captureReason = anomaly.abnormalDrop ? "abnormal loss of oil" : "sensor fault";
+			sensorFaultActive = sensorFault;
+
+			const auto previousPeriod(oilScheduler.GetPeriod(config));
+			oilScheduler.AddSample(config, OilPeriodScheduler::Sample{now, values.volume, daysToEmpty, anomaly.refill, anomaly.abnormalDrop, sensorFault});
+			if (oilScheduler.GetPeriod(config) != previousPeriod)
+				log << "Oil measurement period changed to " << oilScheduler.GetPeriod(config).count() << " min" << std::endl;
+
+			alertDigest = alertManager.BuildDigest(config.alerts, debugText, now);
+
 			const OilDataPoint oilDataPoint(std::chrono::system_clock::now(), values);
 			oilData.push_back(oilDataPoint);
 			oilDataForRateEstimate.push_back(oilDataPoint);
+			history.AddOil(HistoryIndex::OilSample{ToEpochSeconds(oilDataPoint.t), values.distance, values.volume});
+			if (sharedReadings)
+				sharedReadings->PublishOil(ToEpochSeconds(oilDataPoint.t), values.distance, values.volume, daysToEmpty);
+			if (telemetry)
+				telemetry->AddOil(ToEpochSeconds(oilDataPoint.t), values.distance, values.volume);
 
 			if (std::chrono::system_clock::now() > oilLogCreatedDate + std::chrono::minutes(config.logFileRestartPeriod * 24 * 60))
-			{
-				std::string newFileName(oilLogFileName + '_' + GetTimestamp());
-				std::filesystem::rename(oilLogFileName, newFileName);
-				SendNewLogFileEmail(newFileName);
-				WriteLogCreatedDate(oilLogCreatedDateFileName, log);
-				oilLogCreatedDate = ReadLogCreatedDate(oilLogCreatedDateFileName, log);
-			}
+				RotateLogFile(oilLogFileName, oilLogCreatedDateFileName, oilLogCreatedDate);
 		}
 
-		std::unique_lock<std::mutex> lock(stopMutex);
-		stopCondition.wait_until(lock, wakeTime);
+		writeCapture();
+
+		// Send without holding the activity lock so a slow SMTP exchange doesn't delay the other threads
+		if (!alertDigest.IsEmpty())
+		{
+			if (SendAlertEmail(alertDigest))
+				alertManager.MarkSent(alertDigest, std::chrono::system_clock::now());
+			else
+				log << "Warning:  Failed to send alert email; will retry after the next measurement" << std::endl;
+		}
+
+		WaitForNextCycle(startTime, [this]() { return oilScheduler.GetPeriod(liveConfig.Get()); });
 	}
+
+	writeCapture();// After a failed measurement
 }
 
 void OilChecker::TemperatureMeasurementThreadEntry()
 {
 	while (!stopThreads)
 	{
-		const std::chrono::steady_clock::duration period(std::chrono::minutes(config.temperatureMeasurementPeriod));
-		const auto wakeTime(std::chrono::steady_clock::now() + period);
+		const auto startTime(std::chrono::steady_clock::now());
 
 		{
 			std::unique_lock<std::mutex> lock(activityMutex);
+			const OilCheckerConfig& config(liveConfig.Get());
 
 			double temperature;
 			if (!GetTemperature(temperature))
@@ -144,19 +343,18 @@ void OilChecker::TemperatureMeasurementThreadEntry()
 				log << "Warning:  Failed to log temperature data (T = " << temperature << " deg F)" << std::endl;
 
 			temperatureData.push_back(TemperatureDataPoint(std::chrono::system_clock::now(), temperature));
+			forecaster.AddTemperature(temperatureData.back().t, temperature);
+			history.AddTemperature(HistoryIndex::TemperatureSample{ToEpochSeconds(temperatureData.back().t), temperature});
+			if (sharedReadings)
+				sharedReadings->PublishTemperature(ToEpochSeconds(temperatureData.back().t), temperature);
+			if (telemetry)
+				telemetry->AddTemperature(ToEpochSeconds(temperatureData.back().t), temperature);
 
 			if (std::chrono::system_clock::now() > temperatureLogCreatedDate + std::chrono::minutes(config.logFileRestartPeriod * 24 * 60))
-			{
-				std::string newFileName(temperatureLogFileName + '_' + GetTimestamp());
-				std::filesystem::rename(temperatureLogFileName, newFileName);
-				SendNewLogFileEmail(newFileName);
-				WriteLogCreatedDate(temperatureLogCreatedDateFileName, log);
-				temperatureLogCreatedDate = ReadLogCreatedDate(temperatureLogCreatedDateFileName, log);
-			}
+				RotateLogFile(temperatureLogFileName, temperatureLogCreatedDateFileName, temperatureLogCreatedDate);
 		}
 
-		std::unique_lock<std::mutex> lock(stopMutex);
-		stopCondition.wait_until(lock, wakeTime);
+		WaitForNextCycle(startTime, [this]() { return std::chrono::minutes(liveConfig.Get().temperatureMeasurementPeriod); });
 	}
 }
 
@@ -166,11 +364,7 @@ void OilChecker::SummaryUpdateThreadEntry()
 
 	while (!stopThreads)
 	{
-		const std::chrono::steady_clock::duration period(std::chrono::minutes(config.summaryEmailPeriod * 24 * 60));
-		const auto wakeTime(startTime + period);
-
-		std::unique_lock<std::mutex> stopLock(stopMutex);
-		stopCondition.wait_until(stopLock, wakeTime);
+		WaitForNextCycle(startTime, [this]() { return std::chrono::minutes(liveConfig.Get().summaryEmailPeriod * 24 * 60); });
 		startTime = std::chrono::steady_clock::now();
 
 		{
@@ -185,8 +379,102 @@ void OilChecker::SummaryUpdateThreadEntry()
 	}
 }
 
+void OilChecker::ConfigWatchThreadEntry()
+{
+	while (configWatcher.WaitForChange())
+		ReloadConfiguration();
+}
+
+void OilChecker::ReloadConfiguration()
+{
+	log << "Detected change to '" << configFileName << "'; reloading" << std::endl;
+
+	OilCheckerConfigFile configFile(log);
+	if (!configFile.ReadConfiguration(UString::ToStringType(configFileName)))
+	{
+		log << "Warning:  Ignoring invalid edits to '" << configFileName << "'; continuing with previous configuration" << std::endl;
+		return;
+	}
+
+	liveConfig.Publish(LiveConfig::MergeLiveChanges(liveConfig.Get(), configFile.GetConfiguration(), log));
+
+	AsyncLogger::Level logLevel;
+	auto asyncLog(dynamic_cast<AsyncLogger*>(&log));
+	if (asyncLog && AsyncLogger::ParseLevel(liveConfig.Get().logging.level, logLevel))
+		asyncLog->SetMinimumLevel(logLevel);
+	log << "Applied updated configuration" << std::endl;
+
+	// Wake the measurement threads so they re-evaluate their wait times against the new periods
+	std::lock_guard<std::mutex> lock(stopMutex);
+	stopCondition.notify_all();
+}
+
+// Period is re-evaluated each time we wake, so changes to the configured period take effect without waiting out the old one
+void OilChecker::WaitForNextCycle(const std::chrono::steady_clock::time_point& start, const std::function<std::chrono::steady_clock::duration()>& period)
+{
+	std::unique_lock<std::mutex> lock(stopMutex);
+	while (!stopThreads)
+	{
+		const auto wakeTime(start + period());
+		if (std::chrono::steady_clock::now() >= wakeTime)
+			break;
+		stopCondition.wait_until(lock, wakeTime);
+	}
+}
+
+void OilChecker::InitializeAnomalyDetector(std::vector<OilDataPoint>& oilHistory)
+{
+	// Learn the normal consumption rate from the logged history and drop everything before the last refill
+	const AnomalyConfig& config(liveConfig.Get().anomaly);
+	size_t startIndex(0);
+	for (size_t i = 0; i < oilHistory.size(); ++i)
+	{
+		if (anomalyDetector.AddVolume(config, oilHistory[i].t, oilHistory[i].v.volume, std::numeric_limits<double>::quiet_NaN()).refill)
+			startIndex = i;
+	}
+
+	oilHistory.erase(oilHistory.begin(), oilHistory.begin() + startIndex);
+	LimitRateEstimateData(oilHistory);
+}
+
+void OilChecker::InitializeForecaster(const std::vector<OilDataPoint>& oilHistory, const std::vector<TemperatureDataPoint>& temperatureHistory)
+{
+	// Replay the logged history in time order so forecasts are available immediately after a restart
+	const double refillVolume(liveConfig.Get().anomaly.refillVolume);
+	auto oilIt(oilHistory.begin());
+	auto temperatureIt(temperatureHistory.begin());
+	while (oilIt != oilHistory.end() || temperatureIt != temperatureHistory.end())
+	{
+		if (oilIt == oilHistory.end() || (temperatureIt != temperatureHistory.end() && temperatureIt->t < oilIt->t))
+		{
+			forecaster.AddTemperature(temperatureIt->t, temperatureIt->v);
+			++temperatureIt;
+		}
+		else
+		{
+			forecaster.AddVolume(oilIt->t, oilIt->v.volume, refillVolume);
+			++oilIt;
+		}
+	}
+}
+
+// Uses the temperature-aware model once it has seen enough data, otherwise falls back to a linear fit of recent volumes
+ConsumptionForecaster::Forecast OilChecker::ForecastDaysToEmpty(const double& volume) const
+{
+	if (forecaster.IsReady())
+		return forecaster.GetForecast(volume);
+
+	ConsumptionForecaster::Forecast forecast;
+	forecast.daysToEmpty = EstimateDaysToEmpty();
+	forecast.lowerBound = std::numeric_limits<double>::quiet_NaN();
+	forecast.upperBound = std::numeric_limits<double>::quiet_NaN();
+	forecast.consumptionRate = std::numeric_limits<double>::quiet_NaN();
+	return forecast;
+}
+
 double OilChecker::EstimateDaysToEmpty() const
 {
+	const OilCheckerConfig& config(liveConfig.Get());
 	const size_t minDataPoints(5);
 	if (oilDataForRateEstimate.size() < minDataPoints)
 	{
@@ -220,24 +508,12 @@ double OilChecker::EstimateDaysToEmpty() const
 	return daysToEmpty;
 }
 
-void OilChecker::RemoveDataBeforeRefill(std::vector<OilDataPoint>& data) const
+// Refills are handled by anomalyDetector, which clears the data as each one is detected
+void OilChecker::LimitRateEstimateData(std::vector<OilDataPoint>& data) const
 {
+	const OilCheckerConfig& config(liveConfig.Get());
 	if (data.size() > config.measurementCountForEstimatingEmptyDate)
 		data.erase(data.begin(), data.begin() + data.size() - config.measurementCountForEstimatingEmptyDate);
-
-	const double fillDetectionVolume(20.0);// [gal] if there is an increase in volume in excess of this value, assume the tank was filled an ignore all data prior to the increase
-	size_t startIndex;
-	for (startIndex = data.size(); startIndex > 0; --startIndex)
-	{
-		if (data[startIndex - 2].v.volume + fillDetectionVolume < data[startIndex - 1].v.volume)
-		{
-			--startIndex;
-			break;
-		}
-	}
-	
-	if (startIndex > 0)
-		data.erase(data.begin(), data.begin() + startIndex);
 }
 
 bool OilChecker::ReadOilLogData(std::vector<OilDataPoint>& data) const
@@ -263,15 +539,12 @@ bool OilChecker::ReadOilLogData(std::vector<OilDataPoint>& data) const
 		if (!std::getline(lineStream, volumeToken, ','))
 			return false;
 			
-		std::istringstream timeSS(timeToken);
 		std::istringstream distanceSS(distanceToken);
 		std::istringstream volumeSS(volumeToken);
 		
 		OilDataPoint point;
-		std::tm tm = {};
-		if ((timeSS >> std::get_time(&tm, "%Y-%m-%d_%H:%M")).fail())
+		if (!ParseTimestamp(timeToken, point.t))
 			return false;
-		point.t = std::chrono::system_clock::from_time_t(std::mktime(&tm));
 		if ((distanceSS >> point.v.distance).fail())
 			return false;
 		if ((volumeSS >> point.v.volume).fail())
@@ -283,40 +556,113 @@ bool OilChecker::ReadOilLogData(std::vector<OilDataPoint>& data) const
 	return true;
 }
 
-bool OilChecker::GetRemainingOilVolume(VolumeDistance& values) const
+bool OilChecker::ReadTemperatureLogData(std::vector<TemperatureDataPoint>& data) const
+{
+	std::ifstream file(temperatureLogFileName);
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	std::getline(file, line);// Discard header row
+	while (std::getline(file, line))
+	{
+		std::istringstream lineStream(line);
+		std::string timeToken;
+		if (!std::getline(lineStream, timeToken, ','))
+			return false;
+
+		TemperatureDataPoint point;
+		if (!ParseTimestamp(timeToken, point.t))
+			return false;
+		if ((lineStream >> point.v).fail())
+			return false;
+
+		data.push_back(point);
+	}
+
+	return true;
+}
+
+bool OilChecker::GetRemainingOilVolume(VolumeDistance& values, AnomalyDetector::SensorQuality& quality)
 {
 	log << "Reading distance sensor" << std::endl;
+	const OilCheckerConfig& config(liveConfig.Get());
 	
-	PingSensor ping(config.ping.triggerPin, config.ping.echoPin);
+	std::unique_ptr<PingSensor> wiringPiPing;
+	std::unique_ptr<EdgeEventPingSensor> edgeEventPing;
+	std::function<bool(double&, std::chrono::system_clock::time_point&)> getDistance;
+	if (config.ping.simulatedDistance > 0.0)
+	{
+		auto source(std::make_unique<SimulatedEdgeEventSource>());
+		source->SetSteadyEcho(EdgeEventPingSensor::GetEchoDuration(config.ping.simulatedDistance));
+		edgeEventPing = std::make_unique<EdgeEventPingSensor>(std::move(source));
+		getDistance = [&edgeEventPing](double& d, std::chrono::system_clock::time_point& t) { return edgeEventPing->GetDistance(d, t); };
+	}
+	else if (config.ping.useEdgeEvents)
+	{
+		auto source(std::make_unique<GPIOEdgeEventSource>(config.ping.gpioChip, config.ping.triggerLine, config.ping.echoLine, log));
+		if (!source->IsOK())
+			return false;
+		edgeEventPing = std::make_unique<EdgeEventPingSensor>(std::move(source));
+		getDistance = [&edgeEventPing](double& d, std::chrono::system_clock::time_point& t) { return edgeEventPing->GetDistance(d, t); };
+	}
+	else
+	{
+		wiringPiPing = std::make_unique<PingSensor>(config.ping.triggerPin, config.ping.echoPin);
+		getDistance = [&wiringPiPing](double& d, std::chrono::system_clock::time_point&) { return wiringPiPing->GetDistance(d); };
+	}
+
+	const unsigned int measurementsToAverage(config.ping.measurementsToAverage);
 	std::vector<double> measurements;
 	unsigned int attempts(0);
-	while (measurements.size() < distanceMeasurementsToAverage)
+	pingCapture.BeginMeasurement();
+	while (measurements.size() < measurementsToAverage)
 	{		
 		double distance;
+		auto pingTime(std::chrono::system_clock::now());// Replaced by the echo edge time if the backend has one
 		const double minValidDistance(config.tankDimensions.heightOffset);
 		const double maxValidDistance(config.tankDimensions.heightOffset + config.tankDimensions.height);
-		if (attempts == maxDistanceMeasurementsBeforeError)
+		if (attempts == maxAttemptsPerAveragedMeasurement * measurementsToAverage)
 			return false;
-		else if (ping.GetDistance(distance))
+		else if (getDistance(distance, pingTime))
 		{
 			if (distance < minValidDistance || distance > maxValidDistance)
-				log << "Rejecting measurement of " << distance << " in because it is outside of expected range for valid measurements (" << minValidDistance << " to " << maxValidDistance << ")" << std::endl;
+			{
+				pingCapture.Add(pingTime, attempts, PingCapture::Result::OutOfRange, distance);
+				LogDeferred(log, [distance, minValidDistance, maxValidDistance](UString::OStream& s)
+				{
+					s << "Rejecting measurement of " << distance << " in because it is outside of expected range for valid measurements (" << minValidDistance << " to " << maxValidDistance << ")";
+				});
+			}
 			else
+			{
+				pingCapture.Add(pingTime, attempts, PingCapture::Result::Accepted, distance);
 				measurements.push_back(distance);
+			}
 		}
+		else
+			pingCapture.Add(pingTime, attempts, PingCapture::Result::NoEcho, std::numeric_limits<double>::quiet_NaN());
 		++attempts;
 		
-		if (measurements.size() < distanceMeasurementsToAverage)
+		if (measurements.size() < measurementsToAverage)
 			std::this_thread::sleep_for(std::chrono::milliseconds(config.ping.minTimeBetweenPings));
 	}
 	
 	double stdDev;
 	ComputeAverageAndStdDev(measurements, values.distance, stdDev);
-	log << "Averaging " << distanceMeasurementsToAverage << " successful measurements (made " << attempts << " attempts)" << std::endl;
-	log << "Measurement statistics:\n"
-		<< "  Min.      = "<< *std::min_element(measurements.begin(), measurements.end()) / 2.54 << " in\n"
-		<< "  Max.      = "<< *std::max_element(measurements.begin(), measurements.end()) / 2.54 << " in\n"
-		<< "  Std. dev. = "<< stdDev << " in" << std::endl;
+	quality.attempts = attempts;
+	quality.accepted = static_cast<unsigned int>(measurements.size());
+	quality.stdDev = stdDev;
+	log << "Averaging " << measurementsToAverage << " successful measurements (made " << attempts << " attempts)" << std::endl;
+	const double minMeasurement(*std::min_element(measurements.begin(), measurements.end()));
+	const double maxMeasurement(*std::max_element(measurements.begin(), measurements.end()));
+	LogDeferred(log, [minMeasurement, maxMeasurement, stdDev](UString::OStream& s)
+	{
+		s << "Measurement statistics:\n"
+			<< "  Min.      = "<< minMeasurement / 2.54 << " in\n"
+			<< "  Max.      = "<< maxMeasurement / 2.54 << " in\n"
+			<< "  Std. dev. = "<< stdDev << " in";
+	});
 
 	VerticalTankGeometry tank(config.tankDimensions);
 	values.volume = tank.ComputeRemainingVolume(values.distance);
@@ -352,15 +698,6 @@ bool OilChecker::GetTemperature(double& temperature) const
 	return true;
 }
 
-bool OilChecker::SendDebugEmail(const std::string& title, const std::string& body) const
-{
-	EmailSender::LoginInfo loginInfo;
-	std::vector<EmailSender::AddressInfo> recipients;
-	BuildEmailEssentials(loginInfo, recipients);
-	EmailSender sender(title, body, std::string(), recipients, loginInfo, true, false, log);
-	return sender.Send();
-}
-
 bool OilChecker::SendSummaryEmail() const
 {
 	if (stopThreads)
@@ -371,23 +708,28 @@ bool OilChecker::SendSummaryEmail() const
 	ss << "<p>Summary for oil level and outside temperature:</p>\n<table>\n"
 		<< "<tr><th>Date/Time</th><th>Remaining Oil (gal)</th><th>Temperature (deg F)</th></tr>\n";
 		
+	// Stored times are UTC; the summary is for people, so show local time
+	char timeString[Timestamp::bufferSize];
 	unsigned int oilI(0), tempI(0);
 	while (oilI < oilData.size() || tempI < temperatureData.size())
 	{
 		const auto nearDuration(std::chrono::minutes(1));
 		if (oilI >= oilData.size() || (temperatureData[tempI].t < oilData[oilI].t && !WithinDuration(temperatureData[tempI].t, oilData[oilI].t, nearDuration)))
 		{
-			ss << "<tr><td>" << GetTimestamp(temperatureData[tempI].t) << "</td><td></td><td align=3D\"center\">" << std::fixed << static_cast<int>(temperatureData[tempI].v + 0.5) << "</td></tr>\n";
+			Timestamp::Format(ToEpochSeconds(temperatureData[tempI].t), Timestamp::Zone::Local, timeString);
+			ss << "<tr><td>" << timeString << "</td><td></td><td align=3D\"center\">" << std::fixed << static_cast<int>(temperatureData[tempI].v + 0.5) << "</td></tr>\n";
 			++tempI;
 		}
 		else if (tempI >= temperatureData.size() || (oilData[oilI].t < temperatureData[tempI].t && !WithinDuration(temperatureData[tempI].t, oilData[oilI].t, nearDuration)))
 		{
-			ss << "<tr><td>" << GetTimestamp(oilData[oilI].t) << "</td><td align=3D\"center\">" << static_cast<int>(oilData[oilI].v.volume + 0.5) << "</td><td></td></tr>\n";
+			Timestamp::Format(ToEpochSeconds(oilData[oilI].t), Timestamp::Zone::Local, timeString);
+			ss << "<tr><td>" << timeString << "</td><td align=3D\"center\">" << static_cast<int>(oilData[oilI].v.volume + 0.5) << "</td><td></td></tr>\n";
 			++oilI;
 		}
 		else
 		{
-			ss << "<tr><td>" << GetTimestamp(oilData[oilI].t) << "</td><td align=3D\"center\">" << static_cast<int>(oilData[oilI].v.volume + 0.5) << "</td><td align=3D\"center\">" << static_cast<int>(temperatureData[tempI].v + 0.5) << "</td></tr>\n";
+			Timestamp::Format(ToEpochSeconds(oilData[oilI].t), Timestamp::Zone::Local, timeString);
+			ss << "<tr><td>" << timeString << "</td><td align=3D\"center\">" << static_cast<int>(oilData[oilI].v.volume + 0.5) << "</td><td align=3D\"center\">" << static_cast<int>(temperatureData[tempI].v + 0.5) << "</td></tr>\n";
 			++oilI;
 			++tempI;
 		}
@@ -398,9 +740,11 @@ bool OilChecker::SendSummaryEmail() const
 	if (stopThreads)
 		ss << "<p>This email was sent because the oilChecker application has stopped!  Check the log file for details.</p>";
 	
+	std::lock_guard<std::mutex> lock(emailMutex);
 	EmailSender::LoginInfo loginInfo;
 	std::vector<EmailSender::AddressInfo> recipients;
-	BuildEmailEssentials(loginInfo, recipients);
+	if (!BuildEmailEssentials(loginInfo, recipients))
+		return false;
 	EmailSender sender("Oil Level Summary", ss.str(), std::string(), recipients, loginInfo, true, false, log);
 	if (!sender.Send())
 		return false;
@@ -409,34 +753,57 @@ bool OilChecker::SendSummaryEmail() const
 	return true;
 }
 
-bool OilChecker::SendLowOilLevelEmail(const double& volumeRemaining, const double& daysToEmpty) const
+bool OilChecker::SendAlertEmail(const AlertManager::Digest& digest) const
 {
-	log << "Sending low-level warning email" << std::endl;
-	UString::OStringStream ss;
-	ss.precision(1);
-	ss << "Only " << volumeRemaining << " gal of oil remains in the tank.  The tank is projected to be empty in " << daysToEmpty << " days.";
-	
+	log << "Sending alert email (" << digest.subject << ")" << std::endl;
+
+	std::lock_guard<std::mutex> lock(emailMutex);
 	EmailSender::LoginInfo loginInfo;
 	std::vector<EmailSender::AddressInfo> recipients;
-	BuildEmailEssentials(loginInfo, recipients);
-	EmailSender sender("Low Oil Level Detected", ss.str(), std::string(), recipients, loginInfo, false, false, log);
+	if (!BuildEmailEssentials(loginInfo, recipients))
+		return false;
+	EmailSender sender(digest.subject, digest.body, std::string(), recipients, loginInfo, false, false, log);
 	if (!sender.Send())
 		return false;
 
-	log << "Successfully sent low-level warning email" << std::endl;
+	log << "Successfully sent alert email" << std::endl;
 	return true;
 }
 
-bool OilChecker::SendNewLogFileEmail(const std::string& oldLogFileName) const
+void OilChecker::RotateLogFile(const std::string& logFileName, const std::string& createdDateFileName, std::chrono::system_clock::time_point& createdDate)
+{
+	char timeString[Timestamp::bufferSize];
+	Timestamp::Format(Timestamp::Now(), Timestamp::Zone::UTC, timeString);
+	const std::string newFileName(logFileName + '_' + timeString);
+	std::error_code ec;
+	std::filesystem::rename(logFileName, newFileName, ec);
+	if (ec)
+	{
+		log << "ERROR:  Failed to rename '" << logFileName << "':  " << ec.message() << std::endl;
+		return;
+	}
+
+	WriteLogCreatedDate(createdDateFileName, log);
+	createdDate = ReadLogCreatedDate(createdDateFileName, log);
+	logRotator->Enqueue(newFileName);
+}
+
+bool OilChecker::SendNewLogFileEmail(const std::string& oldLogFileName, const std::string& attachmentFileName) const
 {
 	log << "Sending log file complete email for '" << oldLogFileName << "'" << std::endl;
+	const OilCheckerConfig& config(liveConfig.Get());
 	UString::OStringStream ss;
-	ss << "Log file '" << oldLogFileName << "' reached maximum duration of " << config.logFileRestartPeriod << " days.  The old log file has been stored.  It is attached here for reference.";
+	ss << "Log file '" << oldLogFileName << "' reached maximum duration of " << config.logFileRestartPeriod << " days.  The old log file has been stored.  It is attached here for reference";
+	if (attachmentFileName != oldLogFileName)
+		ss << " (gzip-compressed)";
+	ss << ".";
 
+	std::lock_guard<std::mutex> lock(emailMutex);
 	EmailSender::LoginInfo loginInfo;
 	std::vector<EmailSender::AddressInfo> recipients;
-	BuildEmailEssentials(loginInfo, recipients);
-	EmailSender sender("Log File Reached Maximum Duration", ss.str(), oldLogFileName, recipients, loginInfo, false, false, log);
+	if (!BuildEmailEssentials(loginInfo, recipients))
+		return false;
+	EmailSender sender("Log File Reached Maximum Duration", ss.str(), attachmentFileName, recipients, loginInfo, false, false, log);
 	if (!sender.Send())
 		return false;
 
@@ -458,7 +825,9 @@ bool OilChecker::WriteOilLogData(const VolumeDistance& values) const
 	if (needsHeader)
 		file << "Time,Distance (in),Volume (gal)\n";
 	
-	file << GetTimestamp() << ',' << values.distance << ',' << values.volume << '\n';
+	char timeString[Timestamp::bufferSize];
+	Timestamp::Format(Timestamp::Now(), Timestamp::Zone::UTC, timeString);
+	file << timeString << ',' << values.distance << ',' << values.volume << '\n';
 	return true;
 }
 
@@ -476,15 +845,23 @@ bool OilChecker::WriteTemperatureLogData(const double& temperature) const
 	if (needsHeader)
 		file << "Time,Temperature (deg F)\n";
 	
-	file << GetTimestamp() << ',' << temperature << '\n';
+	char timeString[Timestamp::bufferSize];
+	Timestamp::Format(Timestamp::Now(), Timestamp::Zone::UTC, timeString);
+	file << timeString << ',' << temperature << '\n';
 	return true;
 }
 
-void OilChecker::BuildEmailEssentials(EmailSender::LoginInfo& loginInfo, std::vector<EmailSender::AddressInfo>& recipients) const
+bool OilChecker::BuildEmailEssentials(EmailSender::LoginInfo& loginInfo, std::vector<EmailSender::AddressInfo>& recipients) const
 {
+	const OilCheckerConfig& config(liveConfig.Get());
 	loginInfo.smtpUrl = "smtp.gmail.com:587";
 	loginInfo.localEmail = config.email.sender;
-	loginInfo.oAuth2Token = OAuth2Interface::Get().GetRefreshToken();
+	if (!oAuth2.Initialize())
+	{
+		log << "Failed to set up OAuth2" << std::endl;
+		return false;
+	}
+	loginInfo.oAuth2Token = oAuth2.GetRefreshToken();
 	loginInfo.useSSL = true;
 	loginInfo.caCertificatePath = config.email.caCertificatePath;
 
@@ -494,22 +871,142 @@ void OilChecker::BuildEmailEssentials(EmailSender::LoginInfo& loginInfo, std::ve
 		recipients[i].address = config.email.recipients[i];
 		recipients[i].displayName = config.email.recipients[i];
 	}
+
+	return true;
 }
 
-std::string OilChecker::GetTimestamp()
+bool OilChecker::ExportHistory(const std::string& outputDirectory, UString::OStream& log)
 {
-	auto now(std::chrono::system_clock::now());
-	return GetTimestamp(now);
+	const std::filesystem::path directory(outputDirectory);
+	const bool oilOK(ExportLog(oilLogFileName, { "distance_in", "volume_gal" }, (directory / "oilHistory.arrow").string(), log));
+	const bool temperatureOK(ExportLog(temperatureLogFileName, { "temperature_degF" }, (directory / "temperatureHistory.arrow").string(), log));
+	return oilOK && temperatureOK;
 }
 
-std::string OilChecker::GetTimestamp(const std::chrono::system_clock::time_point& now)
+std::vector<std::string> OilChecker::GetArchiveFiles(const std::string& logFileName)
 {
-	std::time_t now_c(std::chrono::system_clock::to_time_t(now));
-	const std::tm now_tm(*std::localtime(&now_c));
-	const size_t timeSize(17);
-	char timeString[timeSize];
-	strftime(timeString, timeSize, "%Y-%m-%d_%H:%M", &now_tm);
-	return std::string(timeString, timeSize - 1);
+	struct Archive
+	{
+		bool haveTime;
+		Timestamp::EpochSeconds t;
+		std::string fileName;
+	};
+
+	std::vector<Archive> archives;
+	const std::string archivePrefix(logFileName + '_');
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::directory_iterator(".", ec))
+	{
+		const std::string name(entry.path().filename().string());
+		if (!entry.is_regular_file(ec) || name.compare(0, archivePrefix.size(), archivePrefix) != 0 ||
+			entry.path().extension() == ".gz")
+			continue;
+
+		// Suffixes mix legacy local times with UTC ("...Z") times, so compare the parsed times rather than the
+		// names; anything after a '.' marks a reduced archive
+		const std::string suffix(name.substr(archivePrefix.size()));
+		Archive archive{false, 0, name};
+		archive.haveTime = Timestamp::Parse(suffix.substr(0, suffix.find('.')), archive.t);
+		archives.push_back(archive);
+	}
+
+	// Unrecognized names go last, in name order
+	std::sort(archives.begin(), archives.end(), [](const Archive& a, const Archive& b)
+	{
+		if (a.haveTime != b.haveTime)
+			return a.haveTime;
+		else if (a.haveTime && a.t != b.t)
+			return a.t < b.t;
+		return a.fileName < b.fileName;
+	});
+
+	std::vector<std::string> fileNames;
+	for (const auto& archive : archives)
+		fileNames.push_back(archive.fileName);
+	return fileNames;
+}
+
+bool OilChecker::ExportLog(const std::string& logFileName, const std::vector<std::string>& valueColumnNames, const std::string& outputFileName, UString::OStream& log)
+{
+	ArrowFileWriter writer(outputFileName, "time", valueColumnNames, log);
+	if (!writer.IsOK())
+		return false;
+
+	std::vector<double> values(valueColumnNames.size());
+	std::size_t rowCount(0);
+	std::vector<std::string> fileNames(GetArchiveFiles(logFileName));
+	fileNames.push_back(logFileName);
+	for (const auto& fileName : fileNames)
+	{
+		std::ifstream file(fileName);
+		if (!file.is_open())
+		{
+			log << "Warning:  Failed to open '" << fileName << "'; skipping" << std::endl;
+			continue;
+		}
+
+		std::string line;
+		std::getline(file, line);// Discard header row
+		unsigned int lineNumber(1);
+		while (std::getline(file, line))
+		{
+			++lineNumber;
+			std::istringstream lineStream(line);
+			std::string token;
+			std::chrono::system_clock::time_point t;
+			bool lineOK(std::getline(lineStream, token, ',') && ParseTimestamp(token, t));
+			for (auto& value : values)
+			{
+				if (lineOK)
+				{
+					std::getline(lineStream, token, ',');
+					std::istringstream valueSS(token);
+					lineOK = !(valueSS >> value).fail();
+				}
+			}
+
+			if (!lineOK)
+			{
+				log << "Warning:  Skipping malformed line " << lineNumber << " of '" << fileName << "'" << std::endl;
+				continue;
+			}
+
+			if (!writer.AddRow(ToEpochSeconds(t), values))
+				return false;
+			++rowCount;
+		}
+	}
+
+	if (!writer.Close())
+		return false;
+
+	log << "Exported " << rowCount << " rows to '" << outputFileName << "'" << std::endl;
+	return true;
+}
+
+bool OilChecker::ParseEpochSeconds(const std::string& timeString, HistoryIndex::EpochSeconds& t)
+{
+	std::chrono::system_clock::time_point timePoint;
+	if (!ParseTimestamp(timeString, timePoint))
+		return false;
+	t = ToEpochSeconds(timePoint);
+	return true;
+}
+
+std::string OilChecker::FormatEpochSeconds(const HistoryIndex::EpochSeconds& t)
+{
+	char timeString[Timestamp::bufferSize];
+	const std::size_t length(Timestamp::Format(t, Timestamp::Zone::UTC, timeString));
+	return std::string(timeString, length);
+}
+
+bool OilChecker::ParseTimestamp(const std::string& timeString, std::chrono::system_clock::time_point& t)
+{
+	Timestamp::EpochSeconds seconds;
+	if (!Timestamp::Parse(timeString, seconds))
+		return false;
+	t = std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+	return true;
 }
 
 std::chrono::system_clock::time_point OilChecker::ReadLogCreatedDate(const std::string& fileName, UString::OStream& log)
@@ -524,17 +1021,19 @@ std::chrono::system_clock::time_point OilChecker::ReadLogCreatedDate(const std::
 	std::string timeString;
 	file >> timeString;
 
-	std::tm tm{};
-	strptime(timeString.c_str(), "%Y-%m-%d_%H:%M", &tm);
-	
-	// Note the result of this conversion can be off by one hour due to daylight savings time.
-	// I haven't found a way to say "just interpret this string as the time in the local time
-	// zone" and have it give the expected results.  I can change the time zone before making
-	// the conversion, which will work if I print the time then, but when I reset the time
-	// zone (to avoid screwing up the other time_points used in this program), it breaks the
-	// time read here again.  So we're going to live with it being off by an hour (maybe) for
-	// now (TODO).
-	return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+	// Seconds since the epoch, or a local time stamp if written by an older version
+	Timestamp::EpochSeconds seconds;
+	std::istringstream ss(timeString);
+	if ((ss >> seconds).fail() || !ss.eof())
+	{
+		if (!Timestamp::Parse(timeString, seconds))
+		{
+			log << "Warning:  Failed to parse '" << fileName << "'; using the current time" << std::endl;
+			return std::chrono::system_clock::now();
+		}
+	}
+
+	return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
 }
 
 bool OilChecker::WriteLogCreatedDate(const std::string& fileName, UString::OStream& log)
@@ -546,7 +1045,7 @@ bool OilChecker::WriteLogCreatedDate(const std::string& fileName, UString::OStre
 		return false;
 	}
 	
-	file << GetTimestamp();
+	file << Timestamp::Now();
 	return true;
 }
 
@@ -560,6 +1059,19 @@ void OilChecker::ComputeAverageAndStdDev(const std::vector<double>& values, doub
 	stdDev = sqrt(sumSqResiduals / values.size());
 }
 
+void OilChecker::WriteDaysToEmpty(UString::OStream& s, const double& days)
+{
+	if (std::isfinite(days))
+		s << days << " days";
+	else
+		s << "never (no consumption expected)";
+}
+
+HistoryIndex::EpochSeconds OilChecker::ToEpochSeconds(const std::chrono::system_clock::time_point& t)
+{
+	return std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+}
+
 bool OilChecker::WithinDuration(const std::chrono::system_clock::time_point& a, const std::chrono::system_clock::time_point& b, const std::chrono::system_clock::duration& d)
 {
 	return std::chrono::abs(a - b) < d;
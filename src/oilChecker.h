@@ -8,6 +8,22 @@
 
 // Local headers
 #include "oilCheckerConfig.h"
+#include "liveConfig.h"
+#include "configFileWatcher.h"
+#include "historyIndex.h"
+#include "queryServer.h"
+#include "sharedReadingsWriter.h"
+#include "telemetryUploader.h"
+#include "consumptionForecaster.h"
+#include "alertManager.h"
+#include "anomalyDetector.h"
+#include "oilPeriodScheduler.h"
+#include "archiveCatalog.h"
+#include "pingCapture.h"
+#include "timestamp.h"
+#include "oAuth2Session.h"
+#include "logRotator.h"
+#include "historyCompactor.h"
 #include "utilities/uString.h"
 #include "email/emailSender.h"
 
@@ -17,25 +33,35 @@
 #include <atomic>
 #include <condition_variable>
 #include <chrono>
+#include <functional>
+#include <memory>
 
 class OilChecker
 {
 public:
-	OilChecker(const OilCheckerConfig& config, UString::OStream& log) : config(config), log(log) {}
+	OilChecker(const OilCheckerConfig& config, const std::string& configFileName, OAuth2Session& oAuth2, UString::OStream& log)
+		: liveConfig(config), configFileName(configFileName), oAuth2(oAuth2), log(log), configWatcher(configFileName, log), alertManager(alertStateFileName, log),
+		archiveCatalog(archiveCatalogFileName, &OilChecker::ParseEpochSeconds, log), pingCapture(config.ping.captureSize, log) {}
 	~OilChecker();
 
 	void Run();
 
+	// Writes the oil and temperature logs, including rotated archives, as Arrow IPC (Feather) files
+	static bool ExportHistory(const std::string& outputDirectory, UString::OStream& log);
+
 private:
 	static const std::string oilLogFileName;
 	static const std::string temperatureLogFileName;
 	static const std::string oilLogCreatedDateFileName;
 	static const std::string temperatureLogCreatedDateFileName;
+	static const std::string alertStateFileName;
+	static const std::string archiveCatalogFileName;
 	
-	static const unsigned int distanceMeasurementsToAverage;
-	static const unsigned int maxDistanceMeasurementsBeforeError;
+	static const unsigned int maxAttemptsPerAveragedMeasurement;
 	
-	OilCheckerConfig config;
+	LiveConfig liveConfig;
+	const std::string configFileName;
+	OAuth2Session& oAuth2;
 	UString::OStream& log;
 	
 	std::chrono::system_clock::time_point oilLogCreatedDate;
@@ -44,17 +70,44 @@ private:
 	std::thread oilMeasurementThread;
 	std::thread temperatureMeasurementThread;
 	std::thread summaryUpdateThread;
+	std::thread configWatchThread;
+	std::thread queryServerThread;
+	std::thread telemetryThread;
+	std::thread logRotationThread;
+	std::thread compactionThread;
 	std::mutex activityMutex;
 
+	// Summaries, alerts and rotated logs are sent from different threads; neither EmailSender nor
+	// the OAuth2 interface is known to be thread-safe.  Never held while taking activityMutex.
+	mutable std::mutex emailMutex;
+
 	std::mutex stopMutex;
 	std::condition_variable stopCondition;
 	std::atomic<bool> stopThreads = false;
 
+	ConfigFileWatcher configWatcher;
+
+	HistoryIndex history;
+	std::unique_ptr<QueryServer> queryServer;
+	std::unique_ptr<SharedReadingsWriter> sharedReadings;
+	std::unique_ptr<TelemetryUploader> telemetry;
+	std::unique_ptr<LogRotator> logRotator;
+	std::unique_ptr<HistoryCompactor> compactor;
+
+	AlertManager alertManager;
+	ArchiveCatalog archiveCatalog;
+	PingCapture pingCapture;
+	bool sensorFaultActive = false;
+
 	void SignalStop();
 
 	void OilMeasurementThreadEntry();
 	void TemperatureMeasurementThreadEntry();
 	void SummaryUpdateThreadEntry();
+	void ConfigWatchThreadEntry();
+
+	void ReloadConfiguration();
+	void WaitForNextCycle(const std::chrono::steady_clock::time_point& start, const std::function<std::chrono::steady_clock::duration()>& period);
 
 	struct VolumeDistance
 	{
@@ -62,12 +115,14 @@ private:
 		double distance;// [in]
 	};
 
-	bool GetRemainingOilVolume(VolumeDistance& values) const;
+	bool GetRemainingOilVolume(VolumeDistance& values, AnomalyDetector::SensorQuality& quality);
 	bool GetTemperature(double& temperature) const;
 	bool SendSummaryEmail() const;
-	bool SendLowOilLevelEmail(const double& volumeRemaining, const double& daysToEmpty) const;
-	bool SendNewLogFileEmail(const std::string& oldLogFileName) const;
-	bool SendDebugEmail(const std::string& title, const std::string& body) const;
+	bool SendAlertEmail(const AlertManager::Digest& digest) const;
+	bool SendNewLogFileEmail(const std::string& oldLogFileName, const std::string& attachmentFileName) const;
+
+	// Call with activityMutex held; only renames, leaving compression and email to logRotator
+	void RotateLogFile(const std::string& logFileName, const std::string& createdDateFileName, std::chrono::system_clock::time_point& createdDate);
 
 	bool WriteOilLogData(const VolumeDistance& values) const;
 	bool WriteTemperatureLogData(const double& temperature) const;
@@ -89,19 +144,37 @@ private:
 	std::vector<OilDataPoint> oilData;
 	std::vector<OilDataPoint> oilDataForRateEstimate;
 	
+	ConsumptionForecaster forecaster;
+	AnomalyDetector anomalyDetector;
+	OilPeriodScheduler oilScheduler;
+
+	ConsumptionForecaster::Forecast ForecastDaysToEmpty(const double& volume) const;
 	double EstimateDaysToEmpty() const;
-	void RemoveDataBeforeRefill(std::vector<OilDataPoint>& data) const;
+	// Days to empty is infinite when no consumption is expected; says so instead of printing "inf"
+	static void WriteDaysToEmpty(UString::OStream& s, const double& days);
+	void LimitRateEstimateData(std::vector<OilDataPoint>& data) const;
 	bool ReadOilLogData(std::vector<OilDataPoint>& data) const;
+	bool ReadTemperatureLogData(std::vector<TemperatureDataPoint>& data) const;
+	void InitializeForecaster(const std::vector<OilDataPoint>& oilHistory, const std::vector<TemperatureDataPoint>& temperatureHistory);
+	void InitializeAnomalyDetector(std::vector<OilDataPoint>& oilHistory);
 
-	void BuildEmailEssentials(EmailSender::LoginInfo& loginInfo, std::vector<EmailSender::AddressInfo>& recipients) const;
+	bool BuildEmailEssentials(EmailSender::LoginInfo& loginInfo, std::vector<EmailSender::AddressInfo>& recipients) const;
 	
-	static std::string GetTimestamp();
-	static std::string GetTimestamp(const std::chrono::system_clock::time_point& now);
+	static bool ParseTimestamp(const std::string& timeString, std::chrono::system_clock::time_point& t);
+
+	static bool ParseEpochSeconds(const std::string& timeString, HistoryIndex::EpochSeconds& t);
+	static std::string FormatEpochSeconds(const HistoryIndex::EpochSeconds& t);
+
+	// Rotated archives, oldest first
+	static std::vector<std::string> GetArchiveFiles(const std::string& logFileName);
+	static bool ExportLog(const std::string& logFileName, const std::vector<std::string>& valueColumnNames, const std::string& outputFileName, UString::OStream& log);
 	static std::chrono::system_clock::time_point ReadLogCreatedDate(const std::string& fileName, UString::OStream& log);
 	static bool WriteLogCreatedDate(const std::string& fileName, UString::OStream& log);
 	
 	static void ComputeAverageAndStdDev(const std::vector<double>& values, double& average, double& stdDev);
 	
+	static HistoryIndex::EpochSeconds ToEpochSeconds(const std::chrono::system_clock::time_point& t);
+
 	static bool WithinDuration(const std::chrono::system_clock::time_point& a, const std::chrono::system_clock::time_point& b, const std::chrono::system_clock::duration& d);
 };
 
@@ -12,20 +12,13 @@
 // Local headers
 #include "utilities/uString.h"
 
-// Local forward declarations
-struct EmailConfig;
-
 class OilCheckerApp
 {
 public:
 	int Run(int argc, char* argv[]);
 
 private:
-	static const std::string oAuthTokenFileName;
-	
 	void PrintUsage(const std::string& calledAs);
-	
-	bool SetupOAuth2Interface(const EmailConfig& email, UString::OStream& log);
 };
 
 #endif// OIL_CHECKER_APP_H_
@@ -25,6 +25,7 @@ struct EmailConfig
 
 	std::string oAuth2ClientID;
 	std::string oAuth2ClientSecret;
+	std::string oAuth2TokenURL = "https://accounts.google.com/o/oauth2/token";
 	std::string caCertificatePath;
 };
 
@@ -33,6 +34,57 @@ struct PingConfig
 	int triggerPin = -1;
 	int echoPin = -1;
 	unsigned int minTimeBetweenPings = 10000;// [ms]
+	unsigned int measurementsToAverage = 10;
+
+	// Kernel-timestamped echo capture via the GPIO character device (pins above are then unused)
+	bool useEdgeEvents = false;
+	std::string gpioChip = "/dev/gpiochip0";
+	int triggerLine = -1;// [BCM line offset]
+	int echoLine = -1;// [BCM line offset]
+
+	// Replaces the sensor with simulated echo edges (for running off-hardware; zero uses the sensor)
+	double simulatedDistance = 0.0;// [cm]
+
+	unsigned int captureSize = 0;// [pings] kept in memory for diagnostics (zero disables capture)
+};
+
+struct AlertConfig
+{
+	double lowLevelHysteresis = 10.0;// [gal]
+	double daysToEmptyHysteresis = 3.0;// [days]
+	unsigned int renotifyPeriod = 24;// [hr]
+	unsigned int escalateAfter = 3;// [notifications]
+};
+
+struct AnomalyConfig
+{
+	double dropThreshold = 15.0;// [gal] excess loss before alerting
+	double dropAllowance = 2.0;// [gal/day] tolerated above the expected consumption rate
+	double refillVolume = 20.0;// [gal] increase treated as a delivery
+	double maxRejectionRate = 0.3;// [-] smoothed fraction of pings rejected before alerting
+	unsigned int stuckSampleCount = 3;// Consecutive measurements with identical pings before alerting (zero to disable)
+};
+
+struct TelemetryConfig
+{
+	std::string url;// Uploads are disabled if empty
+	std::string siteID;
+	unsigned int uploadPeriod = 360;// [min]
+	unsigned int maxBatchSize = 4096;// [samples]
+};
+
+struct LoggingConfig
+{
+	std::string level = "INFO";// ERROR, WARNING or INFO
+	unsigned int maxFileSize = 10;// [MB] (zero disables rotation)
+	unsigned int filesToKeep = 5;
+};
+
+struct RetentionConfig
+{
+	unsigned int rawDays = 90;// [days] before archives are reduced to hourly averages (zero keeps them forever)
+	unsigned int hourlyDays = 730;// [days] before hourly averages are reduced to daily averages (zero keeps them forever)
+	unsigned int diskBudget = 0;// [MB] for the logs, archives and ping captures (zero for no limit)
 };
 
 struct OilCheckerConfig
@@ -41,10 +93,15 @@ struct OilCheckerConfig
 	unsigned int daysToEmptyWarning = 14;// [days]
 	unsigned int measurementCountForEstimatingEmptyDate = 60;
 
+	AlertConfig alerts;
+	AnomalyConfig anomaly;
+
 	TankDimensions tankDimensions;
 
 	unsigned int temperatureMeasurementPeriod = 30;// [min]
 	unsigned int oilMeasurementPeriod = 120;// [min]
+	unsigned int minOilPeriod = 0;// [min] bounds for adaptive scheduling (disabled if maximum is zero)
+	unsigned int maxOilPeriod = 0;// [min]
 	unsigned int summaryEmailPeriod = 7;// [days]
 	unsigned int logFileRestartPeriod = 365;// [days]
 
@@ -53,6 +110,15 @@ struct OilCheckerConfig
 	PingConfig ping;
 	
 	bool sendDebugEmail = false;
+
+	std::string querySocketPath;// Query interface is disabled if empty
+	std::string sharedMemoryName;// Shared memory publishing is disabled if empty
+
+	TelemetryConfig telemetry;
+
+	LoggingConfig logging;
+
+	RetentionConfig retention;
 };
 
 #endif// OIL_CHECKER_CONFIG_H_
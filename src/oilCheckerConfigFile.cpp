@@ -5,6 +5,7 @@
 
 // Local headers
 #include "oilCheckerConfigFile.h"
+#include "asyncLogger.h"
 
 OilCheckerConfigFile::OilCheckerConfigFile(UString::OStream& outStream) : ConfigFile(outStream)
 {
@@ -16,6 +17,17 @@ void OilCheckerConfigFile::BuildConfigItems()
 	AddConfigItem(_T("WARN_IF_EMPTY_WITHIN"), config.daysToEmptyWarning);
 	AddConfigItem(_T("COUNT_FOR_ESTIMATING_EMPTY"), config.measurementCountForEstimatingEmptyDate);
 
+	AddConfigItem(_T("LOW_LEVEL_HYSTERESIS"), config.alerts.lowLevelHysteresis);
+	AddConfigItem(_T("DAYS_TO_EMPTY_HYSTERESIS"), config.alerts.daysToEmptyHysteresis);
+	AddConfigItem(_T("ALERT_RENOTIFY_PERIOD"), config.alerts.renotifyPeriod);
+	AddConfigItem(_T("ALERT_ESCALATE_AFTER"), config.alerts.escalateAfter);
+
+	AddConfigItem(_T("ABNORMAL_DROP_THRESHOLD"), config.anomaly.dropThreshold);
+	AddConfigItem(_T("ABNORMAL_DROP_ALLOWANCE"), config.anomaly.dropAllowance);
+	AddConfigItem(_T("REFILL_DETECTION_VOLUME"), config.anomaly.refillVolume);
+	AddConfigItem(_T("MAX_PING_REJECTION_RATE"), config.anomaly.maxRejectionRate);
+	AddConfigItem(_T("STUCK_SENSOR_COUNT"), config.anomaly.stuckSampleCount);
+
 	AddConfigItem(_T("TANK_WIDTH"), config.tankDimensions.width);
 	AddConfigItem(_T("TANK_HEIGHT"), config.tankDimensions.height);
 	AddConfigItem(_T("TANK_LENGTH"), config.tankDimensions.length);
@@ -23,6 +35,8 @@ void OilCheckerConfigFile::BuildConfigItems()
 
 	AddConfigItem(_T("TEMP_PERIOD"), config.temperatureMeasurementPeriod);
 	AddConfigItem(_T("OIL_PERIOD"), config.oilMeasurementPeriod);
+	AddConfigItem(_T("MIN_OIL_PERIOD"), config.minOilPeriod);
+	AddConfigItem(_T("MAX_OIL_PERIOD"), config.maxOilPeriod);
 	AddConfigItem(_T("SUMMARY_PERIOD"), config.summaryEmailPeriod);
 	AddConfigItem(_T("NEW_LOG_PERIOD"), config.logFileRestartPeriod);
 
@@ -31,12 +45,36 @@ void OilCheckerConfigFile::BuildConfigItems()
 
 	AddConfigItem(_T("OATH2_CLIENT_ID"), config.email.oAuth2ClientID);
 	AddConfigItem(_T("OATH2_CLIENT_SECRET"), config.email.oAuth2ClientSecret);
+	AddConfigItem(_T("OATH2_TOKEN_URL"), config.email.oAuth2TokenURL);
 	
 	AddConfigItem(_T("PING_TRIGGER_PIN"), config.ping.triggerPin);
 	AddConfigItem(_T("PING_ECHO_PIN"), config.ping.echoPin);
 	AddConfigItem(_T("MIN_TIME_BETWEEN_PINGS"), config.ping.minTimeBetweenPings);
+	AddConfigItem(_T("PINGS_TO_AVERAGE"), config.ping.measurementsToAverage);
+	AddConfigItem(_T("PING_USE_EDGE_EVENTS"), config.ping.useEdgeEvents);
+	AddConfigItem(_T("PING_GPIO_CHIP"), config.ping.gpioChip);
+	AddConfigItem(_T("PING_TRIGGER_LINE"), config.ping.triggerLine);
+	AddConfigItem(_T("PING_ECHO_LINE"), config.ping.echoLine);
+	AddConfigItem(_T("PING_SIMULATED_DISTANCE"), config.ping.simulatedDistance);
+	AddConfigItem(_T("PING_CAPTURE_SIZE"), config.ping.captureSize);
 	
 	AddConfigItem(_T("SEND_DEBUG_EMAIL"), config.sendDebugEmail);
+
+	AddConfigItem(_T("QUERY_SOCKET"), config.querySocketPath);
+	AddConfigItem(_T("SHARED_MEMORY_NAME"), config.sharedMemoryName);
+
+	AddConfigItem(_T("TELEMETRY_URL"), config.telemetry.url);
+	AddConfigItem(_T("TELEMETRY_SITE_ID"), config.telemetry.siteID);
+	AddConfigItem(_T("TELEMETRY_PERIOD"), config.telemetry.uploadPeriod);
+	AddConfigItem(_T("TELEMETRY_BATCH_SIZE"), config.telemetry.maxBatchSize);
+
+	AddConfigItem(_T("LOG_LEVEL"), config.logging.level);
+	AddConfigItem(_T("LOG_MAX_SIZE"), config.logging.maxFileSize);
+	AddConfigItem(_T("LOG_FILES_TO_KEEP"), config.logging.filesToKeep);
+
+	AddConfigItem(_T("RAW_RETENTION_DAYS"), config.retention.rawDays);
+	AddConfigItem(_T("HOURLY_RETENTION_DAYS"), config.retention.hourlyDays);
+	AddConfigItem(_T("HISTORY_DISK_BUDGET"), config.retention.diskBudget);
 }
 
 void OilCheckerConfigFile::AssignDefaults()
@@ -54,6 +92,24 @@ bool OilCheckerConfigFile::ConfigIsOK()
 		return false;
 	}
 
+	if (config.alerts.lowLevelHysteresis < 0.0)
+	{
+		outStream << GetKey(config.alerts.lowLevelHysteresis) << " must be positive" << std::endl;
+		ok = false;
+	}
+
+	if (config.alerts.daysToEmptyHysteresis < 0.0)
+	{
+		outStream << GetKey(config.alerts.daysToEmptyHysteresis) << " must be positive" << std::endl;
+		ok = false;
+	}
+
+	if (config.alerts.renotifyPeriod == 0)
+	{
+		outStream << GetKey(config.alerts.renotifyPeriod) << " must be strictly positive" << std::endl;
+		ok = false;
+	}
+
 	if (config.tankDimensions.height <= 0.0)
 	{
 		outStream << GetKey(config.tankDimensions.height) << " must be strictly positive" << std::endl;
@@ -77,6 +133,20 @@ bool OilCheckerConfigFile::ConfigIsOK()
 		outStream << GetKey(config.oilMeasurementPeriod) << " must be strictly positive" << std::endl;
 		ok = false;
 	}
+
+	if (config.maxOilPeriod > 0)
+	{
+		if (config.minOilPeriod == 0)
+		{
+			outStream << GetKey(config.minOilPeriod) << " must be strictly positive when " << GetKey(config.maxOilPeriod) << " is set" << std::endl;
+			ok = false;
+		}
+		else if (config.minOilPeriod > config.maxOilPeriod)
+		{
+			outStream << GetKey(config.minOilPeriod) << " must not exceed " << GetKey(config.maxOilPeriod) << std::endl;
+			ok = false;
+		}
+	}
 	
 	if (config.email.oAuth2ClientID.empty())
 	{
@@ -102,15 +172,110 @@ bool OilCheckerConfigFile::ConfigIsOK()
 		ok = false;
 	}
 	
-	if (config.ping.triggerPin < 0)
+	if (config.ping.simulatedDistance < 0.0)
 	{
-		outStream << GetKey(config.ping.triggerPin) << " must be specified" << std::endl;
+		outStream << GetKey(config.ping.simulatedDistance) << " must be positive" << std::endl;
 		ok = false;
 	}
-	
-	if (config.ping.echoPin < 0)
+
+	// A simulated sensor needs no wiring
+	const bool simulatedPing(config.ping.simulatedDistance > 0.0);
+	if (!simulatedPing && config.ping.useEdgeEvents)
+	{
+		if (config.ping.triggerLine < 0)
+		{
+			outStream << GetKey(config.ping.triggerLine) << " must be specified when " << GetKey(config.ping.useEdgeEvents) << " is set" << std::endl;
+			ok = false;
+		}
+
+		if (config.ping.echoLine < 0)
+		{
+			outStream << GetKey(config.ping.echoLine) << " must be specified when " << GetKey(config.ping.useEdgeEvents) << " is set" << std::endl;
+			ok = false;
+		}
+	}
+	else if (!simulatedPing)
+	{
+		if (config.ping.triggerPin < 0)
+		{
+			outStream << GetKey(config.ping.triggerPin) << " must be specified" << std::endl;
+			ok = false;
+		}
+
+		if (config.ping.echoPin < 0)
+		{
+			outStream << GetKey(config.ping.echoPin) << " must be specified" << std::endl;
+			ok = false;
+		}
+	}
+
+	if (config.ping.measurementsToAverage == 0)
+	{
+		outStream << GetKey(config.ping.measurementsToAverage) << " must be strictly positive" << std::endl;
+		ok = false;
+	}
+
+	if (config.anomaly.dropThreshold <= 0.0)
+	{
+		outStream << GetKey(config.anomaly.dropThreshold) << " must be strictly positive" << std::endl;
+		ok = false;
+	}
+
+	if (config.anomaly.dropAllowance < 0.0)
+	{
+		outStream << GetKey(config.anomaly.dropAllowance) << " must be positive" << std::endl;
+		ok = false;
+	}
+
+	if (config.anomaly.refillVolume <= 0.0)
+	{
+		outStream << GetKey(config.anomaly.refillVolume) << " must be strictly positive" << std::endl;
+		ok = false;
+	}
+
+	if (config.anomaly.maxRejectionRate <= 0.0 || config.anomaly.maxRejectionRate > 1.0)
+	{
+		outStream << GetKey(config.anomaly.maxRejectionRate) << " must be greater than zero and no more than one" << std::endl;
+		ok = false;
+	}
+
+	if (!config.sharedMemoryName.empty() && (config.sharedMemoryName.front() != '/' || config.sharedMemoryName.find('/', 1) != std::string::npos))
+	{
+		outStream << GetKey(config.sharedMemoryName) << " must start with '/' and contain no other '/' characters" << std::endl;
+		ok = false;
+	}
+
+	if (!config.telemetry.url.empty())
+	{
+		if (config.telemetry.siteID.empty())
+		{
+			outStream << GetKey(config.telemetry.siteID) << " must be specified when " << GetKey(config.telemetry.url) << " is set" << std::endl;
+			ok = false;
+		}
+
+		if (config.telemetry.uploadPeriod == 0)
+		{
+			outStream << GetKey(config.telemetry.uploadPeriod) << " must be strictly positive" << std::endl;
+			ok = false;
+		}
+
+		if (config.telemetry.maxBatchSize == 0)
+		{
+			outStream << GetKey(config.telemetry.maxBatchSize) << " must be strictly positive" << std::endl;
+			ok = false;
+		}
+	}
+
+	AsyncLogger::Level level;
+	if (!AsyncLogger::ParseLevel(config.logging.level, level))
+	{
+		outStream << GetKey(config.logging.level) << " must be ERROR, WARNING or INFO" << std::endl;
+		ok = false;
+	}
+
+	if (config.retention.rawDays > 0 && config.retention.hourlyDays > 0 && config.retention.hourlyDays <= config.retention.rawDays)
 	{
-		outStream << GetKey(config.ping.echoPin) << " must be specified" << std::endl;
+		outStream << GetKey(config.retention.hourlyDays) << " must be greater than " << GetKey(config.retention.rawDays) << " (or zero)" << std::endl;
 		ok = false;
 	}
 
@@ -0,0 +1,71 @@
+// File:  oilPeriodScheduler.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Chooses the time until the next oil measurement from recent level changes.
+
+// Local headers
+#include "oilPeriodScheduler.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+const double OilPeriodScheduler::targetVolumeChange(1.5);
+const double OilPeriodScheduler::maxGrowthFactor(2.0);
+const double OilPeriodScheduler::rateSmoothing(0.3);
+
+void OilPeriodScheduler::AddSample(const OilCheckerConfig& config, const Sample& sample)
+{
+	if (!IsAdaptive(config))
+		return;
+
+	const double minPeriod(config.minOilPeriod);
+	const double maxPeriod(config.maxOilPeriod);
+	double desired(config.oilMeasurementPeriod);
+	// A delivery isn't consumption, so the rate estimate starts over from the refilled level
+	if (sample.refill)
+		haveRate = false;
+
+	// Readings taken during a sensor fault aren't trusted for the rate, but the current estimate is kept
+	if (haveSample)
+	{
+		const double minutes(std::chrono::duration<double, std::ratio<60>>(sample.t - lastTime).count());
+		if (minutes > 0.0 && !sample.refill && !sample.sensorFault)
+		{
+			const double rate((sample.volume - lastVolume) / minutes);
+			smoothedRate += (haveRate ? rateSmoothing : 1.0) * (rate - smoothedRate);
+			haveRate = true;
+		}
+
+		const double absRate(std::abs(smoothedRate));
+		if (haveRate)
+			desired = absRate > 0.0 ? targetVolumeChange / absRate : maxPeriod;
+	}
+
+	// Lengthen gradually so a single quiet sample can't jump straight to the maximum; shorten immediately
+	if (period > 0.0)
+		desired = std::min(desired, period * maxGrowthFactor);
+
+	// Within twice the warning window, scale back toward the minimum as the empty date approaches
+	const double urgentDays(2.0 * config.daysToEmptyWarning);
+	if (sample.daysToEmpty < urgentDays)
+		desired = std::min(desired, config.oilMeasurementPeriod * std::max(0.0, sample.daysToEmpty) / urgentDays);
+
+	if (sample.refill || sample.abnormalDrop || (sample.sensorFault && !sensorFaultActive))
+		desired = minPeriod;
+	sensorFaultActive = sample.sensorFault;
+
+	period = std::clamp(desired, minPeriod, maxPeriod);
+	haveSample = true;
+	lastTime = sample.t;
+	lastVolume = sample.volume;
+}
+
+std::chrono::minutes OilPeriodScheduler::GetPeriod(const OilCheckerConfig& config) const
+{
+	if (!IsAdaptive(config) || period == 0.0)
+		return std::chrono::minutes(config.oilMeasurementPeriod);
+
+	const double clamped(std::clamp(period, static_cast<double>(config.minOilPeriod), static_cast<double>(config.maxOilPeriod)));
+	return std::chrono::minutes(static_cast<std::chrono::minutes::rep>(std::lround(clamped)));
+}
@@ -0,0 +1,59 @@
+// File:  oilPeriodScheduler.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Chooses the time until the next oil measurement from recent level changes.
+
+#ifndef OIL_PERIOD_SCHEDULER_H_
+#define OIL_PERIOD_SCHEDULER_H_
+
+// Local headers
+#include "oilCheckerConfig.h"
+
+// Standard C++ headers
+#include <chrono>
+
+// Aims for a roughly constant change in volume between measurements, so the period grows
+// while the level is flat and shrinks when oil is being used quickly.  The period drops to
+// the minimum after a refill, an abnormal loss or the onset of a sensor fault, and is capped as the projected empty date approaches.
+// With adaptive scheduling disabled (maximum period of zero) OIL_PERIOD is used unchanged.
+class OilPeriodScheduler
+{
+public:
+	typedef std::chrono::system_clock::time_point TimePoint;
+
+	struct Sample
+	{
+		TimePoint t;
+		double volume;// [gal]
+		double daysToEmpty;
+		bool refill;
+		bool abnormalDrop;
+		bool sensorFault;// Stays set for as long as the fault persists
+	};
+
+	void AddSample(const OilCheckerConfig& config, const Sample& sample);
+
+	// Clamped to the current configuration, so bound changes apply without a new sample
+	std::chrono::minutes GetPeriod(const OilCheckerConfig& config) const;
+
+private:
+	static const double targetVolumeChange;// [gal]
+	static const double maxGrowthFactor;
+	static const double rateSmoothing;
+
+	bool haveSample = false;
+	TimePoint lastTime;
+	double lastVolume;
+
+	// Signed, so zero-mean measurement noise averages out instead of looking like consumption
+	bool haveRate = false;
+	double smoothedRate = 0.0;// [gal/min]
+
+	bool sensorFaultActive = false;
+
+	double period = 0.0;// [min]; zero until the first sample
+
+	static bool IsAdaptive(const OilCheckerConfig& config) { return config.maxOilPeriod > 0; }
+};
+
+#endif// OIL_PERIOD_SCHEDULER_H_
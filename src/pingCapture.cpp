@@ -0,0 +1,131 @@
+// File:  pingCapture.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Fixed-size in-memory record of individual pings, written to disk only on request.
+
+// Local headers
+#include "pingCapture.h"
+
+// Standard C++ headers
+#include <ctime>
+#include <cerrno>
+#include <algorithm>
+
+const std::string PingCapture::fileNamePrefix("pingCapture_");
+
+PingCapture::PingCapture(const std::size_t& capacity, UString::OStream& log) : log(log), records(capacity)
+{
+}
+
+void PingCapture::BeginMeasurement()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	++measurement;
+}
+
+void PingCapture::Add(const std::chrono::system_clock::time_point& time, const std::uint16_t& attempt, const Result& result, const double& distance)
+{
+	if (records.empty())
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	Record& record(records[next]);
+	record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+	record.distance = distance;
+	record.measurement = measurement;
+	record.attempt = attempt;
+	record.result = result;
+	record.reserved = 0;
+
+	next = (next + 1) % records.size();
+	++added;
+}
+
+bool PingCapture::Flush(const std::string& reason, std::string& fileName)
+{
+	fileName.clear();
+	Snapshot snapshot;
+	if (!TakeSnapshot(snapshot))
+	{
+		if (IsEnabled())
+			log << "No new pings to capture (" << reason << ")" << std::endl;
+		return false;
+	}
+
+	return Write(snapshot, reason, fileName);
+}
+
+// Copy the new records out so the measurement thread is never blocked on file I/O
+bool PingCapture::TakeSnapshot(Snapshot& snapshot)
+{
+	snapshot.records.clear();
+	if (records.empty())
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	const std::size_t count(static_cast<std::size_t>(std::min<std::uint64_t>(added - flushed, records.size())));
+	snapshot.records.reserve(count);
+
+	// Oldest record is at next once the buffer has wrapped
+	const std::size_t first((next + records.size() - count) % records.size());
+	const std::size_t firstPart(std::min(count, records.size() - first));
+	snapshot.records.insert(snapshot.records.end(), records.begin() + first, records.begin() + first + firstPart);
+	snapshot.records.insert(snapshot.records.end(), records.begin(), records.begin() + (count - firstPart));
+	snapshot.addedThrough = added;
+	return count > 0;
+}
+
+bool PingCapture::Write(const Snapshot& snapshot, const std::string& reason, std::string& fileName)
+{
+	fileName.clear();
+	if (snapshot.records.empty())
+		return false;
+
+	std::lock_guard<std::mutex> flushLock(flushMutex);
+	std::FILE* file(CreateFile(fileName));
+	if (!file)
+	{
+		log << "Failed to open '" << fileName << "' for output" << std::endl;
+		return false;
+	}
+
+	const std::uint32_t recordSize(sizeof(Record));
+	const std::uint32_t recordCount(static_cast<std::uint32_t>(snapshot.records.size()));
+	bool ok(std::fwrite("PINGCAP1", 8, 1, file) == 1 &&
+		std::fwrite(&recordSize, sizeof(recordSize), 1, file) == 1 &&
+		std::fwrite(&recordCount, sizeof(recordCount), 1, file) == 1 &&
+		std::fwrite(snapshot.records.data(), sizeof(Record), snapshot.records.size(), file) == snapshot.records.size());
+	ok = std::fclose(file) == 0 && ok;
+	if (!ok)
+	{
+		log << "Failed to write '" << fileName << "'" << std::endl;
+		return false;
+	}
+
+	log << "Wrote " << snapshot.records.size() << " captured pings to '" << fileName << "' (" << reason << ")" << std::endl;
+
+	// Each flush contains only pings not yet written
+	std::lock_guard<std::mutex> lock(mutex);
+	flushed = std::max(flushed, snapshot.addedThrough);
+	return true;
+}
+
+// Never overwrites an earlier capture, even if several are written within the same second
+std::FILE* PingCapture::CreateFile(std::string& fileName) const
+{
+	const std::time_t now(std::time(nullptr));
+	std::tm utc;
+	gmtime_r(&now, &utc);
+	char timeString[32];
+	strftime(timeString, sizeof(timeString), "%Y%m%dT%H%M%SZ", &utc);
+	const std::string baseName(fileNamePrefix + timeString);
+
+	fileName = baseName + ".bin";
+	for (unsigned int i = 1; ; ++i)
+	{
+		std::FILE* file(std::fopen(fileName.c_str(), "wbx"));
+		if (file || errno != EEXIST)
+			return file;
+		fileName = baseName + '_' + std::to_string(i) + ".bin";
+	}
+}
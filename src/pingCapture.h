@@ -0,0 +1,85 @@
+// File:  pingCapture.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Fixed-size in-memory record of individual pings, written to disk only on request.
+
+#ifndef PING_CAPTURE_H_
+#define PING_CAPTURE_H_
+
+// Local headers
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Keeps the most recent pings in a ring buffer allocated up front, so recording costs no
+// allocation or I/O.  Flush() (or TakeSnapshot() followed by Write()) writes the pings buffered since the previous flush (oldest first)
+// to a new file, pingCapture_<UTC time>.bin, with _<n> appended if that name is already taken:
+//   8-byte magic "PINGCAP1", uint32 record size, uint32 record count, then the records,
+// all little endian.  Each record is laid out as PingCapture::Record.
+class PingCapture
+{
+public:
+	PingCapture(const std::size_t& capacity, UString::OStream& log);
+
+	static const std::string fileNamePrefix;
+
+	bool IsEnabled() const { return !records.empty(); }
+
+	enum class Result : std::uint8_t
+	{
+		Accepted,
+		OutOfRange,
+		NoEcho
+	};
+
+	struct Record
+	{
+		std::int64_t time;// [ns] since the epoch (UTC); kernel time of the echo's rising edge when available
+		double distance;// As returned by the sensor; NaN if there was no echo
+		std::uint32_t measurement;// Increments once per averaged measurement
+		std::uint16_t attempt;// Within the measurement, starting from zero
+		Result result;
+		std::uint8_t reserved;
+	};
+
+	static_assert(sizeof(Record) == 24, "Capture file layout depends on record size");
+
+	void BeginMeasurement();
+	void Add(const std::chrono::system_clock::time_point& time, const std::uint16_t& attempt, const Result& result, const double& distance);
+
+	// Returns false if capture is disabled, no pings were added since the last flush (fileName is
+	// left empty) or the file could not be written.  The ring is only locked while it is copied.
+	bool Flush(const std::string& reason, std::string& fileName);
+
+	struct Snapshot
+	{
+		std::vector<Record> records;
+		std::uint64_t addedThrough = 0;
+	};
+
+	// For callers holding other locks:  take the (cheap) snapshot under them and write it after
+	// releasing them.  TakeSnapshot() returns false if there is nothing new to write.
+	bool TakeSnapshot(Snapshot& snapshot);
+	bool Write(const Snapshot& snapshot, const std::string& reason, std::string& fileName);
+
+private:
+	UString::OStream& log;
+
+	std::mutex flushMutex;// Serializes choosing file names
+	std::mutex mutex;
+	std::vector<Record> records;
+	std::size_t next = 0;
+	std::uint64_t added = 0;
+	std::uint64_t flushed = 0;// Value of added when the last successful flush copied the ring
+	std::uint32_t measurement = 0;
+
+	std::FILE* CreateFile(std::string& fileName) const;
+};
+
+#endif// PING_CAPTURE_H_
@@ -0,0 +1,479 @@
+// File:  queryServer.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Local (Unix domain socket) query interface for current and historical readings.
+
+// Local headers
+#include "queryServer.h"
+
+// Standard C++ headers
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <cinttypes>
+#include <algorithm>
+
+// *nix headers
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+const unsigned int QueryServer::maxRequestLength(256);
+const std::size_t QueryServer::maxInputSize(4096);
+const std::size_t QueryServer::maxOutputSize(8 * 1024 * 1024);
+
+QueryServer::QueryServer(const std::string& socketPath, const HistoryIndex& history, const ArchiveCatalog& archives, PingCapture& pingCapture, UString::OStream& log)
+	: socketPath(socketPath), history(history), archives(archives), pingCapture(pingCapture), log(log)
+{
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (socketPath.length() >= sizeof(address.sun_path))
+	{
+		log << "Query socket path '" << socketPath << "' is too long" << std::endl;
+		return;
+	}
+	std::strcpy(address.sun_path, socketPath.c_str());
+
+	listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (listenFd < 0)
+	{
+		log << "Failed to create query socket:  " << std::strerror(errno) << std::endl;
+		return;
+	}
+
+	unlink(socketPath.c_str());// Left over from a previous run
+	if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0)
+	{
+		log << "Failed to listen on '" << socketPath << "':  " << std::strerror(errno) << std::endl;
+		close(listenFd);
+		listenFd = -1;
+		return;
+	}
+
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	completionFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (epollFd < 0 || stopFd < 0 || completionFd < 0)
+	{
+		log << "Failed to create query server event loop:  " << std::strerror(errno) << std::endl;
+		return;
+	}
+
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.fd = listenFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+	event.data.fd = stopFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event);
+	event.data.fd = completionFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, completionFd, &event);
+}
+
+QueryServer::~QueryServer()
+{
+	for (const auto& c : connections)
+		close(c.first);
+
+	if (listenFd >= 0)
+	{
+		close(listenFd);
+		unlink(socketPath.c_str());
+	}
+
+	if (epollFd >= 0)
+		close(epollFd);
+	if (stopFd >= 0)
+		close(stopFd);
+	if (completionFd >= 0)
+		close(completionFd);
+}
+
+void QueryServer::Stop()
+{
+	const uint64_t one(1);
+	if (write(stopFd, &one, sizeof(one)) != sizeof(one))
+		log << "Failed to signal query server to stop" << std::endl;
+}
+
+void QueryServer::Run()
+{
+	workerThread = std::thread(&QueryServer::WorkerThreadEntry, this);
+	EventLoop();
+
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		stopWorker = true;
+	}
+
+	workerCondition.notify_all();
+	workerThread.join();
+}
+
+void QueryServer::EventLoop()
+{
+	const int maxEvents(32);
+	epoll_event events[maxEvents];
+	while (true)
+	{
+		const int count(epoll_wait(epollFd, events, maxEvents, -1));
+		if (count < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			log << "Query server wait failed:  " << std::strerror(errno) << std::endl;
+			return;
+		}
+
+		for (int i = 0; i < count; ++i)
+		{
+			const int fd(events[i].data.fd);
+			if (fd == stopFd)
+				return;
+			else if (fd == listenFd)
+			{
+				AcceptConnections();
+				continue;
+			}
+			else if (fd == completionFd)
+			{
+				HandleCompletedJobs();
+				continue;
+			}
+
+			auto it(connections.find(fd));
+			if (it == connections.end())
+				continue;
+
+			bool keepOpen((events[i].events & (EPOLLERR | EPOLLHUP)) == 0);
+			if (keepOpen && (events[i].events & (EPOLLIN | EPOLLRDHUP)))
+				keepOpen = ReadFromConnection(fd, it->second);
+			if (keepOpen)
+				keepOpen = UpdateConnection(fd, it->second);
+
+			if (!keepOpen)
+				CloseConnection(fd);
+		}
+	}
+}
+
+void QueryServer::AcceptConnections()
+{
+	while (true)
+	{
+		const int fd(accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC));
+		if (fd < 0)
+		{
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				log << "Failed to accept query connection:  " << std::strerror(errno) << std::endl;
+			return;
+		}
+
+		epoll_event event{};
+		event.events = EPOLLIN | EPOLLRDHUP;
+		event.data.fd = fd;
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+		{
+			close(fd);
+			continue;
+		}
+
+		connections[fd].id = nextConnectionID++;
+	}
+}
+
+// Returns false if the connection should be closed
+bool QueryServer::ReadFromConnection(const int& fd, Connection& connection)
+{
+	char buffer[1024];
+	while (connection.input.length() < maxInputSize)
+	{
+		const ssize_t length(read(fd, buffer, sizeof(buffer)));
+		if (length > 0)
+			connection.input.append(buffer, length);
+		else if (length == 0)
+		{
+			connection.peerClosed = true;
+			break;
+		}
+		else if (errno == EAGAIN || errno == EWOULDBLOCK)
+			break;
+		else if (errno != EINTR)
+			return false;
+	}
+
+	return true;
+}
+
+// Handles complete requests until one has to wait for the worker or the replies back up
+void QueryServer::ProcessInput(const int& fd, Connection& connection)
+{
+	std::string::size_type start(0), end;
+	while (!connection.busy && connection.output.length() < maxOutputSize &&
+		(end = connection.input.find('\n', start)) != std::string::npos)
+	{
+		std::string request(connection.input, start, end - start);
+		if (!request.empty() && request.back() == '\r')
+			request.pop_back();
+		start = end + 1;
+
+		if (NeedsWorker(request))
+		{
+			connection.busy = true;
+			{
+				std::lock_guard<std::mutex> lock(workerMutex);
+				pendingJobs.push_back(Job{fd, connection.id, request, std::string()});
+			}
+
+			workerCondition.notify_one();
+		}
+		else
+			HandleRequest(request, connection.output);
+	}
+
+	connection.input.erase(0, start);
+}
+
+// Returns false if the connection should be closed
+bool QueryServer::WriteToConnection(const int& fd, Connection& connection)
+{
+	while (!connection.output.empty())
+	{
+		const ssize_t length(send(fd, connection.output.data(), connection.output.length(), MSG_NOSIGNAL));
+		if (length > 0)
+			connection.output.erase(0, length);
+		else if (errno == EAGAIN || errno == EWOULDBLOCK)
+			break;
+		else if (errno != EINTR)
+			return false;
+	}
+
+	return true;
+}
+
+// Returns false if the connection should be closed
+bool QueryServer::UpdateConnection(const int& fd, Connection& connection)
+{
+	do
+	{
+		ProcessInput(fd, connection);
+		if (!WriteToConnection(fd, connection))
+			return false;
+	} while (!connection.busy && connection.output.length() < maxOutputSize && connection.input.find('\n') != std::string::npos);
+
+	if (connection.input.find('\n') == std::string::npos && connection.input.length() > maxRequestLength)
+		return false;
+
+	// Allow a client to half-close after sending its requests; we hang up once the replies are written
+	if (connection.peerClosed && !connection.busy && connection.output.empty())
+		return false;
+
+	// Stop reading while a request is with the worker or replies are backed up, so neither the
+	// input nor the output can grow without bound; only ask for writability while replies are queued
+	const bool wantInput(!connection.peerClosed && !connection.busy &&
+		connection.output.length() < maxOutputSize && connection.input.length() < maxInputSize);
+	epoll_event event{};
+	event.events = (wantInput ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u) | (connection.output.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+	event.data.fd = fd;
+	epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+	return true;
+}
+
+void QueryServer::CloseConnection(const int& fd)
+{
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+	close(fd);
+	connections.erase(fd);
+}
+
+bool QueryServer::NeedsWorker(const std::string& request)
+{
+	std::istringstream ss(request);
+	std::string command;
+	ss >> command;
+	return command == "OIL" || command == "TEMPERATURE" || command == "CAPTURE";
+}
+
+void QueryServer::WorkerThreadEntry()
+{
+	std::unique_lock<std::mutex> lock(workerMutex);
+	while (true)
+	{
+		workerCondition.wait(lock, [this]() { return stopWorker || !pendingJobs.empty(); });
+		if (stopWorker)
+			return;
+
+		Job job(std::move(pendingJobs.front()));
+		pendingJobs.pop_front();
+
+		lock.unlock();
+		HandleRequest(job.request, job.response);
+		if (job.response.length() > maxOutputSize)
+			job.response = std::string("ERROR reply too large; request a narrower range\n");
+		lock.lock();
+
+		completedJobs.push_back(std::move(job));
+		const uint64_t one(1);
+		if (write(completionFd, &one, sizeof(one)) != sizeof(one))
+			log << "Failed to signal query completion" << std::endl;
+	}
+}
+
+void QueryServer::HandleCompletedJobs()
+{
+	uint64_t count;
+	if (read(completionFd, &count, sizeof(count)) != sizeof(count))
+		return;
+
+	std::deque<Job> completed;
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		completed.swap(completedJobs);
+	}
+
+	for (auto& job : completed)
+	{
+		auto it(connections.find(job.fd));
+		if (it == connections.end() || it->second.id != job.connectionID)
+			continue;// Closed while the request was with the worker
+
+		it->second.output.append(job.response);
+		it->second.busy = false;
+		if (!UpdateConnection(job.fd, it->second))
+			CloseConnection(job.fd);
+	}
+}
+
+void QueryServer::HandleRequest(const std::string& request, std::string& response) const
+{
+	std::istringstream ss(request);
+	std::string command;
+	ss >> command;
+
+	char line[128];
+	if (command == "LATEST")
+	{
+		HistoryIndex::OilSample oil;
+		if (history.GetLatestOil(oil))
+		{
+			snprintf(line, sizeof(line), "%" PRId64 ",", oil.t);
+			response.append(line);
+			AppendValue(response, oil.distance);
+			response.push_back(',');
+			AppendValue(response, oil.volume);
+			response.push_back(',');
+		}
+		else
+			response.append(",,,");
+
+		AppendValue(response, history.GetDaysToEmpty());
+		response.push_back(',');
+
+		HistoryIndex::TemperatureSample temperature;
+		if (history.GetLatestTemperature(temperature))
+		{
+			snprintf(line, sizeof(line), "%" PRId64 ",", temperature.t);
+			response.append(line);
+			AppendValue(response, temperature.temperature);
+		}
+		else
+			response.push_back(',');
+		response.push_back('\n');
+	}
+	else if (command == "DAYS_TO_EMPTY")
+	{
+		AppendValue(response, history.GetDaysToEmpty());
+		response.push_back('\n');
+	}
+	else if (command == "OIL" || command == "TEMPERATURE")
+	{
+		HistoryIndex::EpochSeconds from, to;
+		if ((ss >> from >> to).fail())
+		{
+			response.append("ERROR expected <from> <to>\n");
+			return;
+		}
+
+		if (command == "OIL")
+		{
+			HistoryIndex::OilSample earliest;
+			const bool haveEarliest(history.GetEarliestOil(earliest));
+			AppendArchivedRows(ArchiveCatalog::Series::Oil, from, to, haveEarliest, earliest.t, response);
+
+			std::vector<HistoryIndex::OilSample> samples;
+			history.GetOil(from, to, samples);
+			for (const auto& s : samples)
+			{
+				snprintf(line, sizeof(line), "%" PRId64 ",%g,%g\n", s.t, s.distance, s.volume);
+				response.append(line);
+			}
+		}
+		else
+		{
+			HistoryIndex::TemperatureSample earliest;
+			const bool haveEarliest(history.GetEarliestTemperature(earliest));
+			AppendArchivedRows(ArchiveCatalog::Series::Temperature, from, to, haveEarliest, earliest.t, response);
+
+			std::vector<HistoryIndex::TemperatureSample> samples;
+			history.GetTemperature(from, to, samples);
+			for (const auto& s : samples)
+			{
+				snprintf(line, sizeof(line), "%" PRId64 ",%g\n", s.t, s.temperature);
+				response.append(line);
+			}
+		}
+
+		response.push_back('\n');
+	}
+	else if (command == "CAPTURE")
+	{
+		std::string fileName;
+		if (!pingCapture.IsEnabled())
+			response.append("ERROR ping capture is disabled\n");
+		else if (pingCapture.Flush("requested", fileName))
+			response.append("OK " + fileName + "\n");
+		else if (fileName.empty())
+			response.append("ERROR no pings since the last capture\n");
+		else
+			response.append("ERROR failed to write capture file\n");
+	}
+	else
+		response.append("ERROR unknown request\n");
+}
+
+// Only the part of the range not covered by the in-memory history, so samples are never repeated
+void QueryServer::AppendArchivedRows(const ArchiveCatalog::Series& series, const HistoryIndex::EpochSeconds& from, const HistoryIndex::EpochSeconds& to,
+	const bool& haveEarliest, const HistoryIndex::EpochSeconds& earliest, std::string& response) const
+{
+	const HistoryIndex::EpochSeconds archiveTo(haveEarliest ? std::min(to, earliest - 1) : to);
+	if (archiveTo < from)
+		return;
+
+	std::vector<ArchiveCatalog::Row> rows;
+	archives.Query(series, from, archiveTo, rows);
+
+	char line[64];
+	for (const auto& row : rows)
+	{
+		snprintf(line, sizeof(line), "%" PRId64, row.t);
+		response.append(line);
+		for (const auto& value : row.values)
+		{
+			snprintf(line, sizeof(line), ",%g", value);
+			response.append(line);
+		}
+		response.push_back('\n');
+	}
+}
+
+void QueryServer::AppendValue(std::string& response, const double& value)
+{
+	if (std::isnan(value))
+		return;
+
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%g", value);
+	response.append(buffer);
+}
@@ -0,0 +1,110 @@
+// File:  queryServer.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Local (Unix domain socket) query interface for current and historical readings.
+
+#ifndef QUERY_SERVER_H_
+#define QUERY_SERVER_H_
+
+// Local headers
+#include "historyIndex.h"
+#include "archiveCatalog.h"
+#include "pingCapture.h"
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <unordered_map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+// Line-oriented protocol; each request is one line and times are UTC epoch seconds:
+//   LATEST                 -> <t>,<distance>,<volume>,<daysToEmpty>,<temperature t>,<temperature>
+//   DAYS_TO_EMPTY          -> <daysToEmpty>
+//   OIL <from> <to>        -> one <t>,<distance>,<volume> line per sample, then an empty line
+//   TEMPERATURE <from> <to>-> one <t>,<temperature> line per sample, then an empty line
+//   CAPTURE                -> OK <file name>, after writing the captured pings to that file
+// Unavailable values are left empty.  Malformed requests receive a line starting with "ERROR".
+// Range requests reaching back before the in-memory history are answered from the archive catalog.
+//
+// Range and CAPTURE requests involve disk access, so they are handled on a worker thread while
+// the event loop keeps serving other clients.  Each connection's replies stay in request order.
+// A connection's further requests are not read while its replies back up, and a reply larger
+// than the output limit is replaced by an ERROR line asking for a narrower range.
+class QueryServer
+{
+public:
+	QueryServer(const std::string& socketPath, const HistoryIndex& history, const ArchiveCatalog& archives, PingCapture& pingCapture, UString::OStream& log);
+	~QueryServer();
+
+	bool IsOK() const { return listenFd >= 0 && epollFd >= 0 && stopFd >= 0 && completionFd >= 0; }
+
+	// Services requests until Stop() is called
+	void Run();
+	void Stop();
+
+private:
+	static const unsigned int maxRequestLength;
+	static const std::size_t maxInputSize;
+	static const std::size_t maxOutputSize;
+
+	const std::string socketPath;
+	const HistoryIndex& history;
+	const ArchiveCatalog& archives;
+	PingCapture& pingCapture;
+	UString::OStream& log;
+
+	int listenFd = -1;
+	int epollFd = -1;
+	int stopFd = -1;
+	int completionFd = -1;
+
+	struct Connection
+	{
+		std::uint64_t id;// File descriptors are reused, so completed jobs are matched by id
+		std::string input;
+		std::string output;
+		bool busy = false;// A request is with the worker
+		bool peerClosed = false;
+	};
+
+	std::unordered_map<int, Connection> connections;
+	std::uint64_t nextConnectionID = 0;
+
+	struct Job
+	{
+		int fd;
+		std::uint64_t connectionID;
+		std::string request;
+		std::string response;
+	};
+
+	std::thread workerThread;
+	std::mutex workerMutex;
+	std::condition_variable workerCondition;
+	std::deque<Job> pendingJobs;
+	std::deque<Job> completedJobs;
+	bool stopWorker = false;
+
+	void EventLoop();
+	void AcceptConnections();
+	bool ReadFromConnection(const int& fd, Connection& connection);
+	void ProcessInput(const int& fd, Connection& connection);
+	bool WriteToConnection(const int& fd, Connection& connection);
+	bool UpdateConnection(const int& fd, Connection& connection);
+	void CloseConnection(const int& fd);
+
+	void WorkerThreadEntry();
+	void HandleCompletedJobs();
+	static bool NeedsWorker(const std::string& request);
+
+	void HandleRequest(const std::string& request, std::string& response) const;
+	void AppendArchivedRows(const ArchiveCatalog::Series& series, const HistoryIndex::EpochSeconds& from, const HistoryIndex::EpochSeconds& to,
+		const bool& haveEarliest, const HistoryIndex::EpochSeconds& earliest, std::string& response) const;
+	static void AppendValue(std::string& response, const double& value);
+};
+
+#endif// QUERY_SERVER_H_
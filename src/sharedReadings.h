@@ -0,0 +1,139 @@
+// File:  sharedReadings.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Latest readings published in POSIX shared memory under a seqlock.  The reader
+//        is header-only and depends only on the standard library, so other local
+//        programs can include this file (and link -lrt) to poll the current values
+//        without making any system calls after Open().
+
+#ifndef SHARED_READINGS_H_
+#define SHARED_READINGS_H_
+
+// Standard C++ headers
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// *nix headers
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+struct LiveReadings
+{
+	std::int64_t oilTime = 0;// [sec since epoch, UTC] zero if no reading yet
+	double distance = 0.0;// [in]
+	double volume = 0.0;// [gal]
+	double daysToEmpty = 0.0;// [days]
+
+	std::int64_t temperatureTime = 0;// [sec since epoch, UTC] zero if no reading yet
+	double temperature = 0.0;// [deg F]
+};
+
+// Layout of the shared memory segment.  Every field is accessed atomically (relaxed) and
+// ordered by fences around the sequence counter, so torn reads are detected rather than
+// being undefined behavior.
+struct SharedReadingsSegment
+{
+	static const std::uint32_t magicNumber = 0x4F494C43;// "OILC"
+	static const std::uint32_t currentVersion = 2;
+
+	std::atomic<std::uint32_t> magic;// Identifies a segment created by oilChecker
+	std::atomic<std::uint32_t> version;// Zero until the writer has initialized the segment
+	std::atomic<std::uint32_t> sequence;// Odd while an update is in progress
+
+	std::atomic<std::int64_t> oilTime;
+	std::atomic<double> distance;
+	std::atomic<double> volume;
+	std::atomic<double> daysToEmpty;
+
+	std::atomic<std::int64_t> temperatureTime;
+	std::atomic<double> temperature;
+};
+
+// A lock-based fallback (libatomic) would not be shared between processes, and a reader
+// must never block the writer
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<double>::is_always_lock_free &&
+	std::atomic<std::int64_t>::is_always_lock_free, "Shared readings require lock-free 32- and 64-bit atomics");
+
+class SharedReadingsReader
+{
+public:
+	SharedReadingsReader() = default;
+	SharedReadingsReader(const SharedReadingsReader&) = delete;
+	SharedReadingsReader& operator=(const SharedReadingsReader&) = delete;
+	~SharedReadingsReader() { Close(); }
+
+	// Name must start with '/' (e.g. "/oilChecker").  Returns false (without mapping anything) if the
+	// segment is too small to hold the readings, e.g. because the writer has not yet sized it or the
+	// name belongs to some other program; touching a mapping beyond the end of the object raises SIGBUS.
+	bool Open(const std::string& name)
+	{
+		Close();
+		const int fd(shm_open(name.c_str(), O_RDONLY, 0));
+		if (fd < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SharedReadingsSegment)))
+		{
+			close(fd);
+			return false;
+		}
+
+		void* memory(mmap(nullptr, sizeof(SharedReadingsSegment), PROT_READ, MAP_SHARED, fd, 0));
+		close(fd);
+		if (memory == MAP_FAILED)
+			return false;
+
+		segment = static_cast<const SharedReadingsSegment*>(memory);
+		if (segment->version.load(std::memory_order_acquire) != SharedReadingsSegment::currentVersion ||
+			segment->magic.load(std::memory_order_relaxed) != SharedReadingsSegment::magicNumber)
+		{
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void Close()
+	{
+		if (segment)
+			munmap(const_cast<SharedReadingsSegment*>(segment), sizeof(SharedReadingsSegment));
+		segment = nullptr;
+	}
+
+	// Spins only while the writer is mid-update (a few dozen instructions)
+	bool Read(LiveReadings& readings) const
+	{
+		if (!segment)
+			return false;
+
+		std::uint32_t before, after;
+		do
+		{
+			before = segment->sequence.load(std::memory_order_acquire);
+			if (before & 1)
+				continue;
+
+			readings.oilTime = segment->oilTime.load(std::memory_order_relaxed);
+			readings.distance = segment->distance.load(std::memory_order_relaxed);
+			readings.volume = segment->volume.load(std::memory_order_relaxed);
+			readings.daysToEmpty = segment->daysToEmpty.load(std::memory_order_relaxed);
+			readings.temperatureTime = segment->temperatureTime.load(std::memory_order_relaxed);
+			readings.temperature = segment->temperature.load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after = segment->sequence.load(std::memory_order_relaxed);
+		} while ((before & 1) || before != after);
+
+		return true;
+	}
+
+private:
+	const SharedReadingsSegment* segment = nullptr;
+};
+
+#endif// SHARED_READINGS_H_
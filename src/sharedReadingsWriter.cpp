@@ -0,0 +1,83 @@
+// File:  sharedReadingsWriter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Publishes the latest readings to shared memory (see sharedReadings.h).
+
+// Local headers
+#include "sharedReadingsWriter.h"
+
+// Standard C++ headers
+#include <new>
+#include <cstring>
+#include <cerrno>
+
+SharedReadingsWriter::SharedReadingsWriter(const std::string& name, UString::OStream& log) : name(name)
+{
+	const int fd(shm_open(name.c_str(), O_CREAT | O_RDWR, 0644));
+	if (fd < 0)
+	{
+		log << "Failed to open shared memory '" << name << "':  " << std::strerror(errno) << std::endl;
+		return;
+	}
+
+	void* memory(MAP_FAILED);
+	if (ftruncate(fd, sizeof(SharedReadingsSegment)) == 0)
+		memory = mmap(nullptr, sizeof(SharedReadingsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (memory == MAP_FAILED)
+	{
+		log << "Failed to map shared memory '" << name << "':  " << std::strerror(errno) << std::endl;
+		return;
+	}
+
+	// Readers reject the segment until the version is set, so stale contents from a crashed run are never trusted
+	segment = new (memory) SharedReadingsSegment{};
+	Publish(current);
+	segment->magic.store(SharedReadingsSegment::magicNumber, std::memory_order_relaxed);
+	segment->version.store(SharedReadingsSegment::currentVersion, std::memory_order_release);
+}
+
+SharedReadingsWriter::~SharedReadingsWriter()
+{
+	if (!segment)
+		return;
+
+	munmap(segment, sizeof(SharedReadingsSegment));
+	shm_unlink(name.c_str());
+}
+
+void SharedReadingsWriter::PublishOil(const std::int64_t& t, const double& distance, const double& volume, const double& daysToEmpty)
+{
+	current.oilTime = t;
+	current.distance = distance;
+	current.volume = volume;
+	current.daysToEmpty = daysToEmpty;
+	Publish(current);
+}
+
+void SharedReadingsWriter::PublishTemperature(const std::int64_t& t, const double& temperature)
+{
+	current.temperatureTime = t;
+	current.temperature = temperature;
+	Publish(current);
+}
+
+void SharedReadingsWriter::Publish(const LiveReadings& readings)
+{
+	if (!segment)
+		return;
+
+	const std::uint32_t sequence(segment->sequence.load(std::memory_order_relaxed));
+	segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	segment->oilTime.store(readings.oilTime, std::memory_order_relaxed);
+	segment->distance.store(readings.distance, std::memory_order_relaxed);
+	segment->volume.store(readings.volume, std::memory_order_relaxed);
+	segment->daysToEmpty.store(readings.daysToEmpty, std::memory_order_relaxed);
+	segment->temperatureTime.store(readings.temperatureTime, std::memory_order_relaxed);
+	segment->temperature.store(readings.temperature, std::memory_order_relaxed);
+
+	segment->sequence.store(sequence + 2, std::memory_order_release);
+}
@@ -0,0 +1,33 @@
+// File:  sharedReadingsWriter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Publishes the latest readings to shared memory (see sharedReadings.h).
+
+#ifndef SHARED_READINGS_WRITER_H_
+#define SHARED_READINGS_WRITER_H_
+
+// Local headers
+#include "sharedReadings.h"
+#include "utilities/uString.h"
+
+class SharedReadingsWriter
+{
+public:
+	SharedReadingsWriter(const std::string& name, UString::OStream& log);
+	~SharedReadingsWriter();
+
+	bool IsOK() const { return segment != nullptr; }
+
+	// Wait-free; calls must not overlap (the caller serializes writers)
+	void PublishOil(const std::int64_t& t, const double& distance, const double& volume, const double& daysToEmpty);
+	void PublishTemperature(const std::int64_t& t, const double& temperature);
+
+private:
+	const std::string name;
+	SharedReadingsSegment* segment = nullptr;
+
+	void Publish(const LiveReadings& readings);
+	LiveReadings current;
+};
+
+#endif// SHARED_READINGS_WRITER_H_
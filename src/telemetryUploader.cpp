@@ -0,0 +1,372 @@
+// File:  telemetryUploader.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Queues samples in a durable local backlog and periodically posts them in
+//        compressed batches to a central collector.
+
+// Local headers
+#include "telemetryUploader.h"
+#include "gzipUtilities.h"
+
+// libcurl headers
+#include <curl/curl.h>
+
+// Standard C++ headers
+#include <fstream>
+#include <filesystem>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+const std::string TelemetryUploader::backlogFileName("telemetryBacklog.bin");
+const std::string TelemetryUploader::offsetFileName(".telemetryOffset");
+const std::string TelemetryUploader::backlogMagic("OCTBLOG1");
+const std::size_t TelemetryUploader::backlogHeaderSize(8 + sizeof(std::uint64_t));
+const std::size_t TelemetryUploader::recordSize(sizeof(std::uint8_t) + sizeof(EpochSeconds) + 2 * sizeof(double));
+
+TelemetryUploader::TelemetryUploader(const TelemetryConfig& config, const std::string& caCertificatePath, UString::OStream& log)
+	: config(config), caCertificatePath(caCertificatePath), log(log)
+{
+}
+
+void TelemetryUploader::AddOil(const EpochSeconds& t, const double& distance, const double& volume)
+{
+	Append(Record{RecordType::Oil, t, distance, volume});
+}
+
+void TelemetryUploader::AddTemperature(const EpochSeconds& t, const double& temperature)
+{
+	Append(Record{RecordType::Temperature, t, temperature, 0.0});
+}
+
+void TelemetryUploader::Append(const Record& record)
+{
+	char buffer[recordSize];
+	char* p(buffer);
+	std::memcpy(p, &record.type, sizeof(record.type));
+	p += sizeof(record.type);
+	std::memcpy(p, &record.t, sizeof(record.t));
+	p += sizeof(record.t);
+	std::memcpy(p, &record.a, sizeof(record.a));
+	p += sizeof(record.a);
+	std::memcpy(p, &record.b, sizeof(record.b));
+
+	// Callers may hold activityMutex, so avoid reopening (and stat'ing) the file for every sample
+	std::lock_guard<std::mutex> lock(backlogMutex);
+	if (!backlogFile.is_open())
+	{
+		std::error_code ec;
+		if (!std::filesystem::exists(backlogFileName, ec) && !WriteBacklogHeader(backlogFileName, ReadAcknowledgedOffset()))
+			return;
+		backlogFile.open(backlogFileName, std::ios::app | std::ios::binary);
+	}
+
+	// Flushing hands each record to the kernel right away, as closing the file used to
+	if (!backlogFile.is_open() || !backlogFile.write(buffer, recordSize).flush())
+	{
+		log << "Warning:  Failed to append to telemetry backlog '" << backlogFileName << "'" << std::endl;
+		backlogFile.close();// Try again with a fresh stream on the next sample
+		backlogFile.clear();
+	}
+}
+
+void TelemetryUploader::Run()
+{
+	while (!stopRequested)
+	{
+		{
+			// Only one wakeup per period - the radio is used in a single burst
+			std::unique_lock<std::mutex> lock(stopMutex);
+			stopCondition.wait_for(lock, std::chrono::minutes(config.uploadPeriod), [this]() { return stopRequested.load(); });
+		}
+
+		if (!stopRequested && !UploadBacklog())
+			log << "Warning:  Telemetry upload incomplete; remaining data will be retried next period" << std::endl;
+	}
+}
+
+void TelemetryUploader::Stop()
+{
+	std::lock_guard<std::mutex> lock(stopMutex);
+	stopRequested = true;
+	stopCondition.notify_all();
+}
+
+bool TelemetryUploader::UploadBacklog()
+{
+	std::uint64_t offset(ReadAcknowledgedOffset());
+	std::vector<Record> records;
+	while (!stopRequested)
+	{
+		std::uint64_t nextOffset;
+		if (!ReadBatch(offset, records, nextOffset))
+			return false;
+		else if (records.empty())
+			break;
+
+		offset = nextOffset - records.size() * recordSize;// Skips anything discarded before the backlog's base
+		std::string body;
+		EncodeBatch(records, offset, body);
+		std::string compressed;
+		if (!GZipUtilities::Compress(body, compressed))
+		{
+			log << "Failed to compress telemetry batch" << std::endl;
+			return false;
+		}
+
+		if (!Post(compressed, offset))
+			return false;
+
+		offset = nextOffset;
+		if (!WriteAcknowledgedOffset(offset))
+			return false;
+		log << "Uploaded " << records.size() << " telemetry samples (" << compressed.size() << " bytes)" << std::endl;
+	}
+
+	DiscardAcknowledgedBacklog(offset);
+	return true;
+}
+
+bool TelemetryUploader::ReadBatch(const std::uint64_t& offset, std::vector<Record>& records, std::uint64_t& nextOffset)
+{
+	records.clear();
+	nextOffset = offset;
+
+	std::lock_guard<std::mutex> lock(backlogMutex);
+	std::ifstream file(backlogFileName, std::ios::binary);
+	if (!file.is_open())
+		return true;// Nothing queued yet
+
+	std::uint64_t base, dataStart;
+	if (!ReadBacklogBase(file, base, dataStart))
+		return false;
+
+	// Anything before the base was acknowledged before the file was last emptied
+	nextOffset = std::max(offset, base);
+	file.seekg(dataStart + (nextOffset - base));
+	char buffer[recordSize];
+	while (records.size() < config.maxBatchSize && file.read(buffer, recordSize))
+	{
+		Record record;
+		const char* p(buffer);
+		std::memcpy(&record.type, p, sizeof(record.type));
+		p += sizeof(record.type);
+		std::memcpy(&record.t, p, sizeof(record.t));
+		p += sizeof(record.t);
+		std::memcpy(&record.a, p, sizeof(record.a));
+		p += sizeof(record.a);
+		std::memcpy(&record.b, p, sizeof(record.b));
+
+		records.push_back(record);
+		nextOffset += recordSize;
+	}
+
+	return true;
+}
+
+void TelemetryUploader::EncodeBatch(const std::vector<Record>& records, const std::uint64_t& offset, std::string& body) const
+{
+	body.assign("OCT1");
+	AppendVarint(body, config.siteID.size());
+	body.append(config.siteID);
+	AppendVarint(body, offset);
+
+	for (const RecordType type : { RecordType::Oil, RecordType::Temperature })
+	{
+		std::uint64_t count(0);
+		for (const auto& r : records)
+		{
+			if (r.type == type)
+				++count;
+		}
+		AppendVarint(body, count);
+
+		// Scale to fixed point so slowly-changing values have small deltas
+		const double aScale(type == RecordType::Oil ? 100.0 : 10.0);
+		const double bScale(100.0);
+		EpochSeconds lastT(0);
+		std::int64_t lastA(0), lastB(0);
+		for (const auto& r : records)
+		{
+			if (r.type != type)
+				continue;
+
+			const std::int64_t a(std::llround(r.a * aScale));
+			AppendSignedVarint(body, r.t - lastT);
+			AppendSignedVarint(body, a - lastA);
+			lastT = r.t;
+			lastA = a;
+
+			if (type == RecordType::Oil)
+			{
+				const std::int64_t b(std::llround(r.b * bScale));
+				AppendSignedVarint(body, b - lastB);
+				lastB = b;
+			}
+		}
+	}
+}
+
+bool TelemetryUploader::Post(const std::string& body, const std::uint64_t& offset)
+{
+	CURL* curl(curl_easy_init());
+	if (!curl)
+	{
+		log << "Failed to initialize CURL for telemetry upload" << std::endl;
+		return false;
+	}
+
+	curl_slist* headers(nullptr);
+	headers = curl_slist_append(headers, "Content-Type: application/x-oilchecker-telemetry");
+	headers = curl_slist_append(headers, "Content-Encoding: gzip");
+	headers = curl_slist_append(headers, ("X-Telemetry-Offset: " + std::to_string(offset)).c_str());
+	headers = curl_slist_append(headers, ("X-Telemetry-Site: " + config.siteID).c_str());
+
+	curl_easy_setopt(curl, CURLOPT_URL, config.url.c_str());
+	curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+	curl_easy_setopt(curl, CURLOPT_POST, 1L);
+	curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.data());
+	curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 30L);
+	curl_easy_setopt(curl, CURLOPT_TIMEOUT, 120L);
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char*, size_t size, size_t count, void*) { return size * count; });
+	if (!caCertificatePath.empty())
+		curl_easy_setopt(curl, CURLOPT_CAINFO, caCertificatePath.c_str());
+
+	const CURLcode result(curl_easy_perform(curl));
+	long responseCode(0);
+	if (result == CURLE_OK)
+		curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+
+	curl_slist_free_all(headers);
+	curl_easy_cleanup(curl);
+
+	if (result != CURLE_OK)
+	{
+		log << "Telemetry upload failed:  " << curl_easy_strerror(result) << std::endl;
+		return false;
+	}
+	else if (responseCode < 200 || responseCode >= 300)
+	{
+		log << "Telemetry collector rejected upload (HTTP " << responseCode << ")" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+std::uint64_t TelemetryUploader::ReadAcknowledgedOffset() const
+{
+	std::ifstream file(offsetFileName);
+	std::uint64_t offset(0);
+	if (!file.is_open() || (file >> offset).fail())
+		return 0;
+	return offset - offset % recordSize;// Never resume mid-record
+}
+
+bool TelemetryUploader::WriteAcknowledgedOffset(const std::uint64_t& offset) const
+{
+	// Write and rename so a power loss can't leave a truncated offset behind
+	const std::string tempFileName(offsetFileName + ".tmp");
+	{
+		std::ofstream file(tempFileName);
+		if (!file.is_open() || (file << offset).fail())
+		{
+			log << "Failed to write '" << tempFileName << "'" << std::endl;
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempFileName, offsetFileName, ec);
+	if (ec)
+	{
+		log << "Failed to update '" << offsetFileName << "':  " << ec.message() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+void TelemetryUploader::DiscardAcknowledgedBacklog(const std::uint64_t& acknowledged)
+{
+	std::lock_guard<std::mutex> lock(backlogMutex);
+	std::ifstream file(backlogFileName, std::ios::binary);
+	std::uint64_t base, dataStart;
+	if (!file.is_open() || !ReadBacklogBase(file, base, dataStart))
+		return;
+
+	std::error_code ec;
+	const auto size(std::filesystem::file_size(backlogFileName, ec));
+	if (ec || size <= dataStart || base + (size - dataStart) != acknowledged)
+		return;// Nothing to discard, or samples arrived while uploading; they'll be sent next period
+	file.close();
+
+	// Replacing the file in one rename keeps the base consistent with its contents whenever we stop
+	const std::string tempFileName(backlogFileName + ".tmp");
+	if (!WriteBacklogHeader(tempFileName, acknowledged))
+		return;
+
+	backlogFile.close();// Otherwise Append() would keep writing to the replaced file
+	backlogFile.clear();
+	std::filesystem::rename(tempFileName, backlogFileName, ec);
+	if (ec)
+	{
+		log << "Warning:  Failed to replace '" << backlogFileName << "':  " << ec.message() << std::endl;
+		std::filesystem::remove(tempFileName, ec);
+	}
+}
+
+bool TelemetryUploader::ReadBacklogBase(std::ifstream& file, std::uint64_t& base, std::uint64_t& dataStart) const
+{
+	char header[backlogHeaderSize];
+	file.seekg(0);
+	if (file.read(header, backlogHeaderSize) && backlogMagic.compare(0, backlogMagic.size(), header, backlogMagic.size()) == 0)
+	{
+		std::memcpy(&base, header + backlogMagic.size(), sizeof(base));
+		dataStart = backlogHeaderSize;
+	}
+	else
+	{
+		base = 0;
+		dataStart = 0;
+	}
+
+	file.clear();
+	if (!file.seekg(0))
+	{
+		log << "Failed to read '" << backlogFileName << "'" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool TelemetryUploader::WriteBacklogHeader(const std::string& fileName, const std::uint64_t& base) const
+{
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if (!file.is_open() || !file.write(backlogMagic.data(), backlogMagic.size()) ||
+		!file.write(reinterpret_cast<const char*>(&base), sizeof(base)))
+	{
+		log << "Failed to write '" << fileName << "'" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+void TelemetryUploader::AppendVarint(std::string& s, std::uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		s.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	s.push_back(static_cast<char>(value));
+}
+
+void TelemetryUploader::AppendSignedVarint(std::string& s, const std::int64_t& value)
+{
+	AppendVarint(s, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
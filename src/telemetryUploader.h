@@ -0,0 +1,102 @@
+// File:  telemetryUploader.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Queues samples in a durable local backlog and periodically posts them in
+//        compressed batches to a central collector.
+
+#ifndef TELEMETRY_UPLOADER_H_
+#define TELEMETRY_UPLOADER_H_
+
+// Local headers
+#include "oilCheckerConfig.h"
+#include "utilities/uString.h"
+
+// Standard C++ headers
+#include <string>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+// Batches are sent as an HTTP POST with Content-Encoding: gzip.  The decompressed body is:
+//   "OCT1"                      magic/version
+//   varint  site ID length, followed by the site ID bytes
+//   varint  backlog offset of the first record in the batch (also sent as X-Telemetry-Offset
+//           so the collector can discard batches it has already accepted)
+//   varint  oil sample count, then per sample:  zigzag varint deltas of time [sec],
+//           distance [0.01 in] and volume [0.01 gal] relative to the previous oil sample
+//   varint  temperature sample count, then per sample:  zigzag varint deltas of time [sec]
+//           and temperature [0.1 deg F]
+// The first delta of each series is relative to zero.
+//
+// Offsets count every byte ever queued, so they never repeat.  Once everything has been
+// acknowledged the backlog file is replaced by an empty one whose header records the offset
+// at which it starts:  8-byte magic "OCTBLOG1" followed by a uint64 base offset.  Files
+// without the header (written by older versions) start at offset zero.
+class TelemetryUploader
+{
+public:
+	TelemetryUploader(const TelemetryConfig& config, const std::string& caCertificatePath, UString::OStream& log);
+
+	typedef std::int64_t EpochSeconds;// UTC
+
+	// Appends to the backlog file; safe to call from any thread
+	void AddOil(const EpochSeconds& t, const double& distance, const double& volume);
+	void AddTemperature(const EpochSeconds& t, const double& temperature);
+
+	// Uploads once per period until Stop() is called
+	void Run();
+	void Stop();
+
+private:
+	static const std::string backlogFileName;
+	static const std::string offsetFileName;
+	static const std::string backlogMagic;
+	static const std::size_t backlogHeaderSize;
+
+	const TelemetryConfig config;
+	const std::string caCertificatePath;
+	UString::OStream& log;
+
+	enum class RecordType : std::uint8_t
+	{
+		Oil = 0,
+		Temperature = 1
+	};
+
+	struct Record
+	{
+		RecordType type;
+		EpochSeconds t;
+		double a;// Distance or temperature
+		double b;// Volume (oil only)
+	};
+
+	static const std::size_t recordSize;
+
+	std::mutex backlogMutex;
+	std::ofstream backlogFile;// Kept open between samples; closed whenever the file is replaced
+	std::mutex stopMutex;
+	std::condition_variable stopCondition;
+	std::atomic<bool> stopRequested = false;
+
+	void Append(const Record& record);
+	bool UploadBacklog();
+	bool ReadBatch(const std::uint64_t& offset, std::vector<Record>& records, std::uint64_t& nextOffset);
+	void EncodeBatch(const std::vector<Record>& records, const std::uint64_t& offset, std::string& body) const;
+	bool Post(const std::string& body, const std::uint64_t& offset);
+
+	std::uint64_t ReadAcknowledgedOffset() const;
+	bool WriteAcknowledgedOffset(const std::uint64_t& offset) const;
+	void DiscardAcknowledgedBacklog(const std::uint64_t& acknowledged);
+
+	// Call with backlogMutex held; dataStart is the file position of the record at base
+	bool ReadBacklogBase(std::ifstream& file, std::uint64_t& base, std::uint64_t& dataStart) const;
+	bool WriteBacklogHeader(const std::string& fileName, const std::uint64_t& base) const;
+
+	static void AppendVarint(std::string& s, std::uint64_t value);
+	static void AppendSignedVarint(std::string& s, const std::int64_t& value);
+};
+
+#endif// TELEMETRY_UPLOADER_H_
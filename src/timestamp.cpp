@@ -0,0 +1,174 @@
+// File:  timestamp.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Thread-safe, allocation-free formatting and parsing of log timestamps.
+
+// Local headers
+#include "timestamp.h"
+
+// Standard C++ headers
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <cstring>
+
+Timestamp::EpochSeconds Timestamp::Now()
+{
+	return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::size_t Timestamp::Format(const EpochSeconds& t, const Zone& zone, char* buffer)
+{
+	thread_local Cache utcCache;
+	thread_local Cache localCache;
+
+	Cache& cache(zone == Zone::UTC ? utcCache : localCache);
+	const EpochSeconds minute(FloorDivide(t, 60));
+	if (minute != cache.minute)
+	{
+		cache.length = zone == Zone::UTC ? FormatUTC(minute, cache) : FormatLocal(minute, cache);
+		cache.minute = minute;
+	}
+
+	std::memcpy(buffer, cache.text, cache.length + 1);
+	return cache.length;
+}
+
+std::size_t Timestamp::FormatLogTime(const std::chrono::system_clock::time_point& t, char* buffer)
+{
+	const EpochSeconds milliseconds(std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count());
+	const EpochSeconds seconds(FloorDivide(milliseconds, 1000));
+	Format(seconds, Zone::Local, buffer);
+
+	// Only the seconds and milliseconds change from line to line
+	buffer[10] = ' ';
+	buffer[16] = ':';
+	WriteDigits(static_cast<unsigned int>(seconds - FloorDivide(seconds, 60) * 60), 2, buffer + 17);
+	buffer[19] = '.';
+	WriteDigits(static_cast<unsigned int>(milliseconds - seconds * 1000), 3, buffer + 20);
+	buffer[23] = '\0';
+	return 23;
+}
+
+std::size_t Timestamp::FormatUTC(const EpochSeconds& minute, Cache& cache)
+{
+	const EpochSeconds minutesPerDay(1440);
+	const EpochSeconds day(FloorDivide(minute, minutesPerDay));
+	if (day != cache.day)
+	{
+		int year;
+		unsigned int month, dayOfMonth;
+		CivilFromDays(day, year, month, dayOfMonth);
+		WriteDate(year, month, dayOfMonth, cache.text);
+		cache.day = day;
+	}
+
+	const unsigned int minuteOfDay(static_cast<unsigned int>(minute - day * minutesPerDay));
+	WriteTimeOfDay(minuteOfDay / 60, minuteOfDay % 60, cache.text);
+	cache.text[16] = 'Z';
+	cache.text[17] = '\0';
+	return 17;
+}
+
+// The UTC offset can change at any minute (daylight saving time), so the date isn't cached separately
+std::size_t Timestamp::FormatLocal(const EpochSeconds& minute, Cache& cache)
+{
+	const std::time_t t(static_cast<std::time_t>(minute * 60));
+	std::tm local;
+	if (!localtime_r(&t, &local))
+		return FormatUTC(minute, cache);
+
+	WriteDate(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday, cache.text);
+	cache.day = INT64_MIN;// The date was overwritten, so the UTC fallback must not reuse it
+	WriteTimeOfDay(local.tm_hour, local.tm_min, cache.text);
+	cache.text[16] = '\0';
+	return 16;
+}
+
+void Timestamp::WriteDate(const int& year, const unsigned int& month, const unsigned int& day, char* text)
+{
+	WriteDigits(static_cast<unsigned int>(year), 4, text);
+	text[4] = '-';
+	WriteDigits(month, 2, text + 5);
+	text[7] = '-';
+	WriteDigits(day, 2, text + 8);
+	text[10] = '_';
+}
+
+void Timestamp::WriteTimeOfDay(const unsigned int& hour, const unsigned int& minute, char* text)
+{
+	WriteDigits(hour, 2, text + 11);
+	text[13] = ':';
+	WriteDigits(minute, 2, text + 14);
+}
+
+void Timestamp::WriteDigits(unsigned int value, const unsigned int& count, char* text)
+{
+	for (unsigned int i = count; i > 0; --i)
+	{
+		text[i - 1] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+}
+
+bool Timestamp::Parse(const std::string& timeString, EpochSeconds& t)
+{
+	int year;
+	unsigned int month, day, hour, minute;
+	int length(0);
+	if (sscanf(timeString.c_str(), "%4d-%2u-%2u_%2u:%2u%n", &year, &month, &day, &hour, &minute, &length) != 5 ||
+		month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59)
+		return false;
+
+	const std::string zone(timeString.substr(length));
+	if (zone == "Z")
+	{
+		t = (DaysFromCivil(year, month, day) * 24 + hour) * 3600 + minute * 60;
+		return true;
+	}
+	else if (!zone.empty())
+		return false;
+
+	// Legacy local time stamp; let mktime work out whether daylight saving time applied
+	std::tm local{};
+	local.tm_year = year - 1900;
+	local.tm_mon = month - 1;
+	local.tm_mday = day;
+	local.tm_hour = hour;
+	local.tm_min = minute;
+	local.tm_isdst = -1;
+	const std::time_t converted(std::mktime(&local));
+	if (converted == static_cast<std::time_t>(-1))
+		return false;
+
+	t = converted;
+	return true;
+}
+
+Timestamp::EpochSeconds Timestamp::DaysFromCivil(int year, const unsigned int& month, const unsigned int& day)
+{
+	year -= month <= 2;
+	const EpochSeconds era((year >= 0 ? year : year - 399) / 400);
+	const unsigned int yearOfEra(static_cast<unsigned int>(year - era * 400));
+	const unsigned int dayOfYear((153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1);
+	const unsigned int dayOfEra(yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear);
+	return era * 146097 + static_cast<EpochSeconds>(dayOfEra) - 719468;
+}
+
+void Timestamp::CivilFromDays(EpochSeconds days, int& year, unsigned int& month, unsigned int& day)
+{
+	days += 719468;
+	const EpochSeconds era((days >= 0 ? days : days - 146096) / 146097);
+	const unsigned int dayOfEra(static_cast<unsigned int>(days - era * 146097));
+	const unsigned int yearOfEra((dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365);
+	const unsigned int dayOfYear(dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100));
+	const unsigned int shiftedMonth((5 * dayOfYear + 2) / 153);
+	day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+	month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+	year = static_cast<int>(static_cast<EpochSeconds>(yearOfEra) + era * 400 + (month <= 2));
+}
+
+Timestamp::EpochSeconds Timestamp::FloorDivide(const EpochSeconds& a, const EpochSeconds& b)
+{
+	return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
@@ -0,0 +1,67 @@
+// File:  timestamp.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Thread-safe, allocation-free formatting and parsing of log timestamps.
+
+#ifndef TIMESTAMP_H_
+#define TIMESTAMP_H_
+
+// Standard C++ headers
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+// Logs, archive names and summaries use minute resolution:  "YYYY-MM-DD_HH:MMZ" in UTC for
+// anything stored, or "YYYY-MM-DD_HH:MM" in local time for display.  Files written by older
+// versions have local time stamps without the 'Z'; Parse() still accepts them.  Log lines are
+// stamped to the millisecond in local time, "YYYY-MM-DD HH:MM:SS.mmm", built on the same cache.
+class Timestamp
+{
+public:
+	typedef std::int64_t EpochSeconds;// UTC
+
+	enum class Zone
+	{
+		UTC,
+		Local
+	};
+
+	static constexpr std::size_t bufferSize = 18;// Including the terminating null
+	static constexpr std::size_t logBufferSize = 24;// Including the terminating null
+
+	static EpochSeconds Now();
+
+	// Writes a null-terminated string to buffer (at least bufferSize chars) and returns its length.
+	// Each thread caches its last result, so only the time of day is reformatted when the minute
+	// changes and the date only when the day changes.
+	static std::size_t Format(const EpochSeconds& t, const Zone& zone, char* buffer);
+
+	// Writes a null-terminated log line time stamp to buffer (at least logBufferSize chars) and returns its length
+	static std::size_t FormatLogTime(const std::chrono::system_clock::time_point& t, char* buffer);
+
+	static bool Parse(const std::string& timeString, EpochSeconds& t);
+
+private:
+	struct Cache
+	{
+		EpochSeconds minute = INT64_MIN;
+		EpochSeconds day = INT64_MIN;
+		std::size_t length = 0;
+		char text[bufferSize] = {};
+	};
+
+	static std::size_t FormatUTC(const EpochSeconds& minute, Cache& cache);
+	static std::size_t FormatLocal(const EpochSeconds& minute, Cache& cache);
+
+	static void WriteDate(const int& year, const unsigned int& month, const unsigned int& day, char* text);
+	static void WriteTimeOfDay(const unsigned int& hour, const unsigned int& minute, char* text);
+	static void WriteDigits(unsigned int value, const unsigned int& count, char* text);
+
+	// Proleptic Gregorian calendar conversions, independent of the time zone
+	static EpochSeconds DaysFromCivil(int year, const unsigned int& month, const unsigned int& day);
+	static void CivilFromDays(EpochSeconds days, int& year, unsigned int& month, unsigned int& day);
+
+	static EpochSeconds FloorDivide(const EpochSeconds& a, const EpochSeconds& b);
+};
+
+#endif// TIMESTAMP_H_